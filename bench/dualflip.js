@@ -0,0 +1,59 @@
+// Compares the Harris ratio test with the long-step (bound flipping)
+// ratio test (rTest: RT_FLIP) of the dual simplex on synthetic sparse
+// LPs whose columns are all double-bounded:
+//
+//   node bench/dualflip.js [runs]
+//
+// Both ratio tests must reach the same optimum.
+var glp = require('..');
+var synthetic = require('./synthetic');
+
+glp.termOutput(false);
+
+var runs = parseInt(process.argv[2] || '3', 10);
+
+// all columns are double-bounded
+var shape = {
+    dir: glp.MIN,
+    value: function(rand) {
+        return rand() % 19 - 9 || 1;
+    },
+    column: function(lp, j, rand) {
+        lp.setColBnds(j, glp.DB, -(rand() % 3), 1 + rand() % 4);
+        lp.setObjCoef(j, rand() % 41 - 20);
+    },
+    row: function(lp, i, rand) {
+        lp.setRowBnds(i, glp.DB, -20 + rand() % 40, 20 + rand() % 40);
+    }
+};
+
+function solve(make, rTest) {
+    var best = Infinity, result, iters;
+    for (var r = 0; r < runs; r++) {
+        var lp = make();
+        var start = process.hrtime();
+        lp.simplexSync({ msgLev: glp.MSG_OFF, meth: glp.DUAL, rTest: rTest });
+        var d = process.hrtime(start);
+        best = Math.min(best, d[0] * 1e3 + d[1] / 1e6);
+        result = lp.getObjVal();
+        iters = lp.getItCnt();
+        lp.delete();
+    }
+    return { ms: best, result: result, iters: iters };
+}
+
+var problems = [
+    ['300x1000/6', synthetic(300, 1000, 6, 1, shape)],
+    ['1000x3000/8', synthetic(1000, 3000, 8, 2, shape)],
+    ['2000x8000/8', synthetic(2000, 8000, 8, 3, shape)]
+];
+
+console.log('best of ' + runs + ' runs');
+problems.forEach(function(p) {
+    var harris = solve(p[1], glp.RT_HAR);
+    var flip = solve(p[1], glp.RT_FLIP);
+    var same = Math.abs(harris.result - flip.result) <= 1e-6 * (1 + Math.abs(harris.result));
+    console.log(p[0] + ': ' + harris.ms.toFixed(1) + ' ms / ' + harris.iters + ' it Harris, ' +
+        flip.ms.toFixed(1) + ' ms / ' + flip.iters + ' it flip (' + (harris.ms / flip.ms).toFixed(2) + 'x)' +
+        (same ? '' : ', OPTIMA DIFFER'));
+});
@@ -0,0 +1,63 @@
+// Measures Problem#loadMatrix and Problem#setMatCol on a multi-million
+// nonzero matrix. Run it against two builds to compare them:
+//
+//   node bench/loadmatrix.js [nonzeros] [rows]
+//
+var glp = require('..');
+
+glp.termOutput(false);
+
+var nnz = parseInt(process.argv[2] || '5000000', 10);
+var rows = parseInt(process.argv[3] || '50000', 10);
+var perCol = 50;
+var cols = Math.ceil(nnz / perCol);
+nnz = cols * perCol;
+
+// column-major layout so that setMatCol can reuse slices of the same data
+var ia = new Int32Array(nnz + 1);
+var ja = new Int32Array(nnz + 1);
+var ar = new Float64Array(nnz + 1);
+var seed = 12345;
+function rand() {
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    return seed;
+}
+for (var j = 1, k = 1; j <= cols; j++) {
+    var base = rand() % (rows - perCol);
+    for (var t = 0; t < perCol; t++, k++) {
+        ia[k] = base + t + 1;
+        ja[k] = j;
+        ar[k] = 1 + (rand() % 1000) / 100;
+    }
+}
+
+function time(label, fn) {
+    var start = process.hrtime();
+    fn();
+    var d = process.hrtime(start);
+    var ms = d[0] * 1e3 + d[1] / 1e6;
+    console.log(label + ': ' + ms.toFixed(1) + ' ms (' + (nnz / ms / 1e3).toFixed(2) + ' M nonzeros/s)');
+    return ms;
+}
+
+console.log(rows + ' rows, ' + cols + ' columns, ' + nnz + ' nonzeros');
+
+var lp = new glp.Problem();
+lp.addRows(rows);
+lp.addCols(cols);
+time('loadMatrix', function() {
+    lp.loadMatrix(nnz, ia, ja, ar);
+});
+lp.delete();
+
+lp = new glp.Problem();
+lp.addRows(rows);
+lp.addCols(cols);
+time('setMatCol ', function() {
+    for (var j = 1; j <= cols; j++) {
+        // subarray views share the backing store; element 0 of each view is ignored
+        var from = (j - 1) * perCol;
+        lp.setMatCol(j, ia.subarray(from, from + perCol + 1), ar.subarray(from, from + perCol + 1));
+    }
+});
+lp.delete();
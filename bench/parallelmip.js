@@ -0,0 +1,64 @@
+// Compares the deterministic parallel branch-and-bound (parDet) with the
+// opportunistic one on random multi-dimensional knapsacks, and checks that
+// repeated deterministic searches end with the same solution:
+//
+//   node bench/parallelmip.js [threads] [items] [runs]
+//
+var glp = require('..');
+
+glp.termOutput(false);
+
+var threads = parseInt(process.argv[2] || '4', 10);
+var items = parseInt(process.argv[3] || '40', 10);
+var runs = parseInt(process.argv[4] || '5', 10);
+
+function knapsack(seed) {
+    function rand() {
+        seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+        return seed;
+    }
+    var lp = new glp.Problem();
+    lp.setObjDir(glp.MAX);
+    lp.addRows(3);
+    lp.addCols(items);
+    var ind = new Int32Array(items + 1);
+    var val = new Float64Array(items + 1);
+    for (var j = 1; j <= items; j++) {
+        ind[j] = j;
+        lp.setColKind(j, glp.BV);
+        lp.setObjCoef(j, 1 + rand() % 1000);
+    }
+    for (var i = 1; i <= 3; i++) {
+        for (j = 1; j <= items; j++) val[j] = 1 + rand() % 1000;
+        lp.setMatRow(i, items, ind, val);
+        lp.setRowBnds(i, glp.UP, 0.0, 100.0 * items);
+    }
+    lp.simplexSync({ msgLev: glp.MSG_OFF });
+    return lp;
+}
+
+function run(label, parm) {
+    var total = 0;
+    var solutions = [];
+    for (var r = 0; r < runs; r++) {
+        var lp = knapsack(r + 1);
+        var start = process.hrtime();
+        lp.intoptSync(parm);
+        var d = process.hrtime(start);
+        total += d[0] * 1e3 + d[1] / 1e6;
+        solutions.push(Array.prototype.join.call(lp.mipColValArray(), ''));
+        lp.delete();
+    }
+    console.log(label + ': ' + (total / runs).toFixed(1) + ' ms per search');
+    return solutions;
+}
+
+console.log(runs + ' knapsacks, ' + items + ' items, ' + threads + ' threads');
+
+var parm = { msgLev: glp.MSG_OFF, threads: threads, brTech: glp.BR_MFV };
+run('opportunistic', parm);
+parm.parDet = glp.ON;
+var first = run('deterministic', parm);
+var second = run('deterministic', parm);
+var same = first.every(function(x, r) { return x === second[r]; });
+console.log('deterministic searches ' + (same ? 'repeat' : 'DIFFER'));
@@ -0,0 +1,50 @@
+// Compares the steepest edge weight updates of the primal and the dual
+// simplex with the vectorised kernels off and on (simd option), on
+// synthetic sparse LPs with many non-basic columns for the primal and
+// many rows for the dual, where the updates take most of an iteration.
+//
+//   node bench/segamma.js [runs] [iterations]
+//
+// Every solve is stopped after the same number of iterations, which
+// take the same path with both settings; the time per iteration is
+// reported.
+var glp = require('..');
+var synthetic = require('./synthetic');
+
+glp.termOutput(false);
+
+var runs = parseInt(process.argv[2] || '3', 10);
+var iters = parseInt(process.argv[3] || '300', 10);
+
+function solve(make, meth, simd) {
+    var best = Infinity, done;
+    for (var r = 0; r < runs; r++) {
+        var lp = make();
+        var start = process.hrtime();
+        lp.simplexSync({ msgLev: glp.MSG_OFF, meth: meth, itLim: iters, simd: simd });
+        var d = process.hrtime(start);
+        done = lp.getItCnt();
+        best = Math.min(best, (d[0] * 1e3 + d[1] / 1e6) / done);
+        lp.delete();
+    }
+    return { ms: best, iters: done };
+}
+
+var problems = [
+    ['primal', glp.PRIMAL, '200x2500/8', synthetic(200, 2500, 8, 1, synthetic.packing)],
+    ['primal', glp.PRIMAL, '200x5200/8', synthetic(200, 5200, 8, 2, synthetic.packing)],
+    ['primal', glp.PRIMAL, '200x10000/8', synthetic(200, 10000, 8, 3, synthetic.packing)],
+    ['primal', glp.PRIMAL, '200x40000/8', synthetic(200, 40000, 8, 4, synthetic.packing)],
+    ['dual', glp.DUAL, '10000x12000/4', synthetic(10000, 12000, 4, 5, synthetic.packing)],
+    ['dual', glp.DUAL, '20000x24000/4', synthetic(20000, 24000, 4, 6, synthetic.packing)],
+    ['dual', glp.DUAL, '40000x48000/4', synthetic(40000, 48000, 4, 7, synthetic.packing)]
+];
+
+console.log('best of ' + runs + ' runs, ' + iters + ' iterations');
+problems.forEach(function(p) {
+    var off = solve(p[3], p[1], glp.OFF);
+    var on = solve(p[3], p[1], glp.ON);
+    console.log(p[0] + ' ' + p[2] + ': ' + off.ms.toFixed(3) + ' ms/it scalar, ' +
+        on.ms.toFixed(3) + ' ms/it simd (' + (off.ms / on.ms).toFixed(2) + 'x)' +
+        (off.iters === on.iters ? '' : ', ITERATIONS DIFFER'));
+});
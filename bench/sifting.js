@@ -0,0 +1,41 @@
+// Compares the primal simplex method with sifting (meth: SIFTING) on
+// synthetic sparse LPs with many more columns than rows:
+//
+//   node bench/sifting.js [runs]
+//
+// Both methods must reach the same optimum.
+var glp = require('..');
+var synthetic = require('./synthetic');
+
+glp.termOutput(false);
+
+var runs = parseInt(process.argv[2] || '3', 10);
+
+function solve(make, meth) {
+    var best = Infinity, result;
+    for (var r = 0; r < runs; r++) {
+        var lp = make();
+        var start = process.hrtime();
+        lp.simplexSync({ msgLev: glp.MSG_OFF, meth: meth });
+        var d = process.hrtime(start);
+        best = Math.min(best, d[0] * 1e3 + d[1] / 1e6);
+        result = lp.getObjVal();
+        lp.delete();
+    }
+    return { ms: best, result: result };
+}
+
+var problems = [
+    ['200x20000/5', synthetic(200, 20000, 5, 1, synthetic.packing)],
+    ['500x50000/6', synthetic(500, 50000, 6, 2, synthetic.packing)],
+    ['1000x100000/6', synthetic(1000, 100000, 6, 3, synthetic.packing)]
+];
+
+console.log('best of ' + runs + ' runs');
+problems.forEach(function(p) {
+    var primal = solve(p[1], glp.PRIMAL);
+    var sifting = solve(p[1], glp.SIFTING);
+    var same = Math.abs(primal.result - sifting.result) <= 1e-6 * (1 + Math.abs(primal.result));
+    console.log(p[0] + ': ' + primal.ms.toFixed(1) + ' ms primal, ' + sifting.ms.toFixed(1) +
+        ' ms sifting (' + (primal.ms / sifting.ms).toFixed(2) + 'x)' + (same ? '' : ', OPTIMA DIFFER'));
+});
@@ -0,0 +1,54 @@
+// Compares the simplex method with and without the vectorised matrix
+// kernels (simd option) on the 25fv47 example and on synthetic sparse LPs
+// whose rows and columns are long enough for the kernels to be used:
+//
+//   node bench/simplex.js [runs]
+//
+// Both settings must take the same path, so the iteration counts and the
+// objective values are checked to be identical.
+var path = require('path');
+var glp = require('..');
+var synthetic = require('./synthetic');
+
+glp.termOutput(false);
+
+var runs = parseInt(process.argv[2] || '3', 10);
+
+function netlib(name) {
+    return function() {
+        var lp = new glp.Problem();
+        lp.readMpsSync(glp.MPS_DECK, null, path.join(__dirname, '..', 'examples', name + '.mps'));
+        return lp;
+    };
+}
+
+function solve(make, meth, simd) {
+    var best = Infinity, result;
+    for (var r = 0; r < runs; r++) {
+        var lp = make();
+        var start = process.hrtime();
+        lp.simplexSync({ msgLev: glp.MSG_OFF, meth: meth, simd: simd });
+        var d = process.hrtime(start);
+        best = Math.min(best, d[0] * 1e3 + d[1] / 1e6);
+        result = lp.getItCnt() + ' ' + lp.getObjVal();
+        lp.delete();
+    }
+    return { ms: best, result: result };
+}
+
+var problems = [
+    ['25fv47', netlib('25fv47')],
+    ['1000x3000/8', synthetic(1000, 3000, 8, 1)],
+    ['2000x6000/12', synthetic(2000, 6000, 12, 2)],
+    ['1000x10000/30', synthetic(1000, 10000, 30, 3)]
+];
+
+console.log('best of ' + runs + ' runs');
+problems.forEach(function(p) {
+    [[glp.PRIMAL, 'primal'], [glp.DUAL, 'dual']].forEach(function(m) {
+        var off = solve(p[1], m[0], glp.OFF);
+        var on = solve(p[1], m[0], glp.ON);
+        console.log(p[0] + ' ' + m[1] + ': ' + off.ms.toFixed(1) + ' ms scalar, ' + on.ms.toFixed(1) +
+            ' ms simd (' + (off.ms / on.ms).toFixed(2) + 'x)' + (on.result === off.result ? '' : ', PATHS DIFFER'));
+    });
+});
@@ -0,0 +1,66 @@
+// Synthetic sparse LPs for the simplex benchmarks: every column has
+// perCol nonzeros spread over the rows. The shape gives the objective
+// direction and draws the nonzeros, the column bounds and costs, and the
+// row bounds; by default all are those of bench/simplex.js.
+var glp = require('..');
+
+var defaultShape = {
+    dir: glp.MIN,
+    value: function(rand) {
+        return 1 + rand() % 9;
+    },
+    column: function(lp, j, rand) {
+        lp.setColBnds(j, glp.DB, 0.0, 10.0);
+        lp.setObjCoef(j, -(1 + rand() % 20));
+    },
+    row: function(lp, i, rand) {
+        lp.setRowBnds(i, glp.UP, 0.0, 50 + rand() % 100);
+    }
+};
+
+// returns a function creating the LP, the same one on every call
+function synthetic(rows, cols, perCol, seed, shape) {
+    shape = Object.assign({}, defaultShape, shape);
+    return function() {
+        var state = seed;
+        function rand() {
+            state = (state * 1103515245 + 12345) & 0x7fffffff;
+            return state;
+        }
+        var nnz = cols * perCol;
+        var ia = new Int32Array(nnz + 1);
+        var ja = new Int32Array(nnz + 1);
+        var ar = new Float64Array(nnz + 1);
+        var lp = new glp.Problem();
+        lp.setObjDir(shape.dir);
+        lp.addRows(rows);
+        lp.addCols(cols);
+        for (var j = 1, k = 1; j <= cols; j++) {
+            var base = rand() % rows;
+            for (var t = 0; t < perCol; t++, k++) {
+                // distinct rows within a column
+                ia[k] = (base + t * Math.floor(rows / perCol)) % rows + 1;
+                ja[k] = j;
+                ar[k] = shape.value(rand);
+            }
+            shape.column(lp, j, rand);
+        }
+        for (var i = 1; i <= rows; i++) shape.row(lp, i, rand);
+        lp.loadMatrix(nnz, ia, ja, ar);
+        return lp;
+    };
+}
+
+// packing LP: maximize a positive objective subject to capacities
+synthetic.packing = {
+    dir: glp.MAX,
+    column: function(lp, j, rand) {
+        lp.setColBnds(j, glp.DB, 0.0, 10.0);
+        lp.setObjCoef(j, 1 + rand() % 50);
+    },
+    row: function(lp, i, rand) {
+        lp.setRowBnds(i, glp.UP, 0.0, 100 + rand() % 100);
+    }
+};
+
+module.exports = synthetic;
@@ -2,7 +2,7 @@
 	"targets": [
 		{
 			"target_name": "glpk",
-			"sources": [ "src/nodeglpk.cc", "src/problem.hpp", "src/tree.hpp"],
+			"sources": [ "src/nodeglpk.cc", "src/problem.hpp", "src/tree.hpp", "src/descriptor.hpp", "src/solverpool.hpp", "src/scheduler.hpp", "src/plugins.hpp", "src/parallelmip.hpp", "src/miprace.hpp"],
 			"cflags": ["-std=c++11", "-Wall", "-Wextra", "-Wno-unused-parameter", "-fexceptions"],
 			"cflags_cc": ["-std=c++11", "-Wall", "-Wextra", "-Wno-unused-parameter", "-fexceptions"],
 			"defines": [
@@ -172,28 +172,129 @@ static NAN_METHOD(NAME) {\
     V8CHECK(info.Length() != 3, "Wrong number of arguments");\
     V8CHECK(!info[0]->IsUint32() || !info[1]->IsInt32Array() || !info[2]->IsFloat64Array(), "Wrong arguments");\
     \
-    Local<Int32Array> ja = Local<Int32Array>::Cast(info[1]);\
-    Local<Float64Array> ar = Local<Float64Array>::Cast(info[2]);\
+    Nan::TypedArrayContents<int> ja(info[1]);\
+    Nan::TypedArrayContents<double> ar(info[2]);\
     \
-    uint32_t count = ja->Length();\
-    V8CHECK(ar->Length() != count, "the tow arrays must have the same length");\
+    size_t count = ja.length();\
+    V8CHECK(ar.length() != count, "the tow arrays must have the same length");\
+    V8CHECK(count < 1, "Invalid Array size");\
     count--;\
     \
     CLASS* host = ObjectWrap::Unwrap<CLASS>(info.Holder());\
     V8CHECK(!host->handle, "object deleted");\
     V8CHECK(host->thread.load(), "an async operation is inprogress")\
     \
-    int* pja = (int*)malloc(ja->Length() * sizeof(int));\
-    double* par = (double*)malloc(ar->Length() * sizeof(double));\
+    GLP_CREATE_HOOK_GUARDS(host); \
+    GLP_CATCH_RET(API(host->handle, info[0]->Int32Value(), (int)count, *ja, *ar);)\
+}
+
+#define GLP_BIND_TYPEDARRAY(CLASS, NAME, COUNT, API, ARRAY, TYPE)\
+static NAN_METHOD(NAME) {\
+    V8CHECK(info.Length() > 1, "Wrong number of arguments");\
+    V8CHECK((info.Length() == 1) && !info[0]->Is##ARRAY(), "Wrong arguments");\
     \
-    for (size_t i = 0; i < ja->Length(); i++) pja[i] = ja->Get(i)->Int32Value();\
-    for (size_t i = 0; i < ar->Length(); i++) par[i] = ar->Get(i)->NumberValue();\
+    CLASS* host = ObjectWrap::Unwrap<CLASS>(info.Holder());\
+    V8CHECK(!host->handle, "object deleted");\
+    V8CHECK(host->thread.load(), "an async operation is inprogress")\
     \
     GLP_CREATE_HOOK_GUARDS(host); \
-    GLP_CATCH_RET(API(host->handle, info[0]->Int32Value(), count, pja, par);)\
+    GLP_CATCH_RET(int count = COUNT(host->handle);\
+    Local<ARRAY> ret;\
+    if (info.Length() == 1) {\
+        ret = Local<ARRAY>::Cast(info[0]);\
+        V8CHECK(ret->Length() <= (size_t)count, "Invalid Array size");\
+    } else {\
+        ret = ARRAY::New(ArrayBuffer::New(Isolate::GetCurrent(), sizeof(TYPE) * (count + 1)), 0, count + 1);\
+    }\
+    Nan::TypedArrayContents<TYPE> val(ret);\
+    for (int i = 1; i <= count; i++) (*val)[i] = API(host->handle, i);\
+    info.GetReturnValue().Set(ret);)\
+}
+
+#define GLP_BIND_FLOAT64ARRAY(CLASS, NAME, COUNT, API)\
+    GLP_BIND_TYPEDARRAY(CLASS, NAME, COUNT, API, Float64Array, double)
+
+#define GLP_BIND_INT32ARRAY(CLASS, NAME, COUNT, API)\
+    GLP_BIND_TYPEDARRAY(CLASS, NAME, COUNT, API, Int32Array, int)
+
+#define GLP_CHECK_ARRAY_RANGE(ARR, COUNT, FIRST, LAST, E)\
+    for (size_t k = 1; k <= (COUNT); k++) {\
+        V8CHECK(((ARR)[k] < (FIRST)) || ((ARR)[k] > (LAST)), E);\
+    }
+
+#define GLP_BIND_VOID_INT32ARRAY_INT32ARRAY_FLOAT64ARRAY_FLOAT64ARRAY(CLASS, NAME, COUNT, FIRST, API, TFIRST, TLAST)\
+static NAN_METHOD(NAME) {\
+    V8CHECK(info.Length() != 4, "Wrong number of arguments");\
+    V8CHECK(!info[0]->IsInt32Array() || !info[1]->IsInt32Array()\
+            || !info[2]->IsFloat64Array() || !info[3]->IsFloat64Array(), "Wrong arguments");\
+    \
+    Nan::TypedArrayContents<int> idx(info[0]);\
+    Nan::TypedArrayContents<int> type(info[1]);\
+    Nan::TypedArrayContents<double> lb(info[2]);\
+    Nan::TypedArrayContents<double> ub(info[3]);\
+    \
+    size_t count = idx.length();\
+    V8CHECK(count < 1, "Invalid Array size");\
+    V8CHECK((type.length() != count) || (lb.length() != count) || (ub.length() != count),\
+            "the arrays must have the same length");\
+    count--;\
+    \
+    CLASS* host = ObjectWrap::Unwrap<CLASS>(info.Holder());\
+    V8CHECK(!host->handle, "object deleted");\
+    V8CHECK(host->thread.load(), "an async operation is inprogress")\
     \
-    free(pja);\
-    free(par);\
+    GLP_CREATE_HOOK_GUARDS(host); \
+    GLP_CATCH_RET(int last = COUNT(host->handle);\
+    GLP_CHECK_ARRAY_RANGE(*idx, count, FIRST, last, "Index out of range");\
+    GLP_CHECK_ARRAY_RANGE(*type, count, TFIRST, TLAST, "Invalid type");\
+    for (size_t k = 1; k <= count; k++) API(host->handle, (*idx)[k], (*type)[k], (*lb)[k], (*ub)[k]);)\
+}
+
+#define GLP_BIND_VOID_INT32ARRAY_FLOAT64ARRAY(CLASS, NAME, COUNT, FIRST, API)\
+static NAN_METHOD(NAME) {\
+    V8CHECK(info.Length() != 2, "Wrong number of arguments");\
+    V8CHECK(!info[0]->IsInt32Array() || !info[1]->IsFloat64Array(), "Wrong arguments");\
+    \
+    Nan::TypedArrayContents<int> idx(info[0]);\
+    Nan::TypedArrayContents<double> val(info[1]);\
+    \
+    size_t count = idx.length();\
+    V8CHECK(count < 1, "Invalid Array size");\
+    V8CHECK(val.length() != count, "the arrays must have the same length");\
+    count--;\
+    \
+    CLASS* host = ObjectWrap::Unwrap<CLASS>(info.Holder());\
+    V8CHECK(!host->handle, "object deleted");\
+    V8CHECK(host->thread.load(), "an async operation is inprogress")\
+    \
+    GLP_CREATE_HOOK_GUARDS(host); \
+    GLP_CATCH_RET(int last = COUNT(host->handle);\
+    GLP_CHECK_ARRAY_RANGE(*idx, count, FIRST, last, "Index out of range");\
+    for (size_t k = 1; k <= count; k++) API(host->handle, (*idx)[k], (*val)[k]);)\
+}
+
+#define GLP_BIND_VOID_INT32ARRAY_INT32ARRAY(CLASS, NAME, COUNT, FIRST, API, VFIRST, VLAST)\
+static NAN_METHOD(NAME) {\
+    V8CHECK(info.Length() != 2, "Wrong number of arguments");\
+    V8CHECK(!info[0]->IsInt32Array() || !info[1]->IsInt32Array(), "Wrong arguments");\
+    \
+    Nan::TypedArrayContents<int> idx(info[0]);\
+    Nan::TypedArrayContents<int> val(info[1]);\
+    \
+    size_t count = idx.length();\
+    V8CHECK(count < 1, "Invalid Array size");\
+    V8CHECK(val.length() != count, "the arrays must have the same length");\
+    count--;\
+    \
+    CLASS* host = ObjectWrap::Unwrap<CLASS>(info.Holder());\
+    V8CHECK(!host->handle, "object deleted");\
+    V8CHECK(host->thread.load(), "an async operation is inprogress")\
+    \
+    GLP_CREATE_HOOK_GUARDS(host); \
+    GLP_CATCH_RET(int last = COUNT(host->handle);\
+    GLP_CHECK_ARRAY_RANGE(*idx, count, FIRST, last, "Index out of range");\
+    GLP_CHECK_ARRAY_RANGE(*val, count, VFIRST, VLAST, "Wrong arguments");\
+    for (size_t k = 1; k <= count; k++) API(host->handle, (*idx)[k], (*val)[k]);)\
 }
 
 #define GLP_BIND_VALUE_INT32_CALLBACK(CLASS, NAME, API)\
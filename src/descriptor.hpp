@@ -0,0 +1,362 @@
+#pragma once
+#ifndef _NODE_GLPK_DESCRIPTOR_HPP
+#define _NODE_GLPK_DESCRIPTOR_HPP
+
+#include <ctype.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <node.h>
+#include "glpk/glpk.h"
+#include "common.h"
+
+namespace NodeGLPK {
+
+    using namespace v8;
+
+    /*
+     * Whole-problem description used by Problem.fromDescriptor:
+     *
+     * {
+     *   name: 'prob', objDir: glp.MAX, rows: m, cols: n,
+     *   matrix: {format: 'csr' | 'csc', start: Int32Array, index: Int32Array, value: Float64Array}
+     *         | {format: 'coo', ne: k, ia: Int32Array, ja: Int32Array, ar: Float64Array},
+     *   names: {rows: [...], cols: [...]},
+     *   bounds: {rows: {type, lb, ub}, cols: {type, lb, ub}},
+     *   obj: Float64Array, kinds: Int32Array
+     * }
+     *
+     * Every array follows the GLPK convention and is indexed from 1 (element 0 is
+     * ignored, except obj[0] which is the constant term). For csr/csc, start[1..m+1]
+     * (resp. n+1) holds the positions of each row (column) in index/value, so
+     * start[1] == 1 and the matrix has start[m+1] - 1 elements.
+     *
+     * Parse() only reads the shape of the object and must run on the main thread;
+     * Validate() and Build() only touch the backing stores and may run in a worker.
+     */
+    class ProblemDescriptor {
+    public:
+        enum Format { NONE, CSR, CSC, COO };
+
+        ProblemDescriptor()
+            : hasName(false), objDir(0), rows(0), cols(0), format(NONE),
+              start(NULL), index(NULL), value(NULL), startLen(0), indexLen(0), valueLen(0), ne(0), ia(NULL), ja(NULL),
+              rowType(NULL), colType(NULL), rowLb(NULL), rowUb(NULL), colLb(NULL), colUb(NULL),
+              obj(NULL), kinds(NULL) {}
+
+        // pins receives every typed array referenced by the descriptor so that an
+        // async caller can keep them alive until Build() has run
+        bool Parse(Local<Value> descriptor, std::vector<Local<Value> >* pins) {
+            V8CHECKBOOL(!descriptor->IsObject(), "descriptor: should be an object");
+            Local<Object> desc = descriptor->ToObject();
+
+            Local<Value> val = Field(desc, "rows");
+            V8CHECKBOOL(!val->IsInt32() || val->Int32Value() < 0, "rows: should be a non-negative int32");
+            rows = val->Int32Value();
+            val = Field(desc, "cols");
+            V8CHECKBOOL(!val->IsInt32() || val->Int32Value() < 0, "cols: should be a non-negative int32");
+            cols = val->Int32Value();
+
+            val = Field(desc, "name");
+            if (!val->IsUndefined()) {
+                V8CHECKBOOL(!val->IsString(), "name: should be a string");
+                name = V8TOCSTRING(val);
+                hasName = true;
+            }
+            val = Field(desc, "objDir");
+            if (!val->IsUndefined()) {
+                V8CHECKBOOL(!val->IsInt32(), "objDir: should be int32");
+                objDir = val->Int32Value();
+                V8CHECKBOOL(objDir != GLP_MIN && objDir != GLP_MAX, "objDir: invalid direction");
+            }
+
+            val = Field(desc, "matrix");
+            if (!val->IsUndefined() && !val->IsNull())
+                if (!ParseMatrix(val, pins)) return false;
+
+            val = Field(desc, "names");
+            if (!val->IsUndefined() && !val->IsNull()) {
+                V8CHECKBOOL(!val->IsObject(), "names: should be an object");
+                Local<Object> names = val->ToObject();
+                if (!ParseNames(names, "rows", rows, rowNames)) return false;
+                if (!ParseNames(names, "cols", cols, colNames)) return false;
+            }
+
+            val = Field(desc, "bounds");
+            if (!val->IsUndefined() && !val->IsNull()) {
+                V8CHECKBOOL(!val->IsObject(), "bounds: should be an object");
+                Local<Object> bounds = val->ToObject();
+                if (!ParseBounds(bounds, "rows", rows, &rowType, &rowLb, &rowUb, pins)) return false;
+                if (!ParseBounds(bounds, "cols", cols, &colType, &colLb, &colUb, pins)) return false;
+            }
+
+            size_t len;
+            if (!ArrayField(desc, "obj", &Value::IsFloat64Array, "Float64Array", cols, &obj, &len, pins))
+                return false;
+            if (!ArrayField(desc, "kinds", &Value::IsInt32Array, "Int32Array", cols, &kinds, &len, pins))
+                return false;
+            return true;
+        }
+
+        // returns an empty string when the descriptor can be handed to Build()
+        std::string Validate() const {
+            std::string error;
+            if (hasName && !ValidName(name))
+                return "name: invalid problem name";
+            for (size_t k = 0; k < rowNames.size(); k++)
+                if (!ValidName(rowNames[k].second))
+                    return Message("names.rows", rowNames[k].first, "invalid name");
+            for (size_t k = 0; k < colNames.size(); k++)
+                if (!ValidName(colNames[k].second))
+                    return Message("names.cols", colNames[k].first, "invalid name");
+
+            if (rowType)
+                for (int i = 1; i <= rows; i++)
+                    if (rowType[i] < GLP_FR || rowType[i] > GLP_FX)
+                        return Message("bounds.rows.type", i, "invalid type");
+            if (colType)
+                for (int j = 1; j <= cols; j++)
+                    if (colType[j] < GLP_FR || colType[j] > GLP_FX)
+                        return Message("bounds.cols.type", j, "invalid type");
+            if (kinds)
+                for (int j = 1; j <= cols; j++)
+                    if (kinds[j] < GLP_CV || kinds[j] > GLP_BV)
+                        return Message("kinds", j, "invalid kind");
+
+            switch (format) {
+                case CSR: return ValidateCompressed(rows, cols);
+                case CSC: return ValidateCompressed(cols, rows);
+                case COO: return ValidateCoordinate();
+                default: return error;
+            }
+        }
+
+        void Build(glp_prob* P) const {
+            if (hasName) glp_set_prob_name(P, name.c_str());
+            if (objDir) glp_set_obj_dir(P, objDir);
+            if (rows > 0) glp_add_rows(P, rows);
+            if (cols > 0) glp_add_cols(P, cols);
+
+            for (size_t k = 0; k < rowNames.size(); k++)
+                glp_set_row_name(P, rowNames[k].first, rowNames[k].second.c_str());
+            for (size_t k = 0; k < colNames.size(); k++)
+                glp_set_col_name(P, colNames[k].first, colNames[k].second.c_str());
+
+            if (rowType)
+                for (int i = 1; i <= rows; i++)
+                    glp_set_row_bnds(P, i, rowType[i], rowLb[i], rowUb[i]);
+            if (colType)
+                for (int j = 1; j <= cols; j++)
+                    glp_set_col_bnds(P, j, colType[j], colLb[j], colUb[j]);
+            if (obj)
+                for (int j = 0; j <= cols; j++)
+                    glp_set_obj_coef(P, j, obj[j]);
+            if (kinds)
+                for (int j = 1; j <= cols; j++)
+                    glp_set_col_kind(P, j, kinds[j]);
+
+            // glp_set_mat_row/col expect ind[1..len], hence the -1 on each slice
+            if (format == CSR) {
+                for (int i = 1; i <= rows; i++)
+                    glp_set_mat_row(P, i, start[i + 1] - start[i], index + start[i] - 1, value + start[i] - 1);
+            } else if (format == CSC) {
+                for (int j = 1; j <= cols; j++)
+                    glp_set_mat_col(P, j, start[j + 1] - start[j], index + start[j] - 1, value + start[j] - 1);
+            } else if (format == COO) {
+                glp_load_matrix(P, ne, ia, ja, value);
+            }
+        }
+
+    private:
+        static Local<Value> Field(Local<Object> obj, const char* key) {
+            return obj->Get(Nan::New<String>(key).ToLocalChecked());
+        }
+
+        static std::string Message(const char* field, int k, const char* what) {
+            return std::string(field) + "[" + std::to_string(k) + "]: " + what;
+        }
+
+        // same rules as glp_set_prob_name/glp_set_row_name, which would otherwise abort
+        static bool ValidName(const std::string& s) {
+            if (s.size() > 255) return false;
+            for (size_t k = 0; k < s.size(); k++)
+                if (iscntrl((unsigned char)s[k])) return false;
+            return true;
+        }
+
+        // optional typed array of at least count + 1 elements
+        template <typename T>
+        static bool ArrayField(Local<Object> obj, const char* key, bool (Value::*is)() const, const char* type,
+                               int count, const T** data, size_t* length, std::vector<Local<Value> >* pins) {
+            Local<Value> val = Field(obj, key);
+            if (val->IsUndefined() || val->IsNull()) return true;
+            if (!((*val)->*is)()) {
+                std::string error(key);
+                error += ": should be an ";
+                error += type;
+                V8CHECKBOOL(true, error.c_str());
+            }
+            Nan::TypedArrayContents<T> contents(val);
+            if (contents.length() <= (size_t)count) {
+                std::string error(key);
+                error += ": Invalid Array size";
+                V8CHECKBOOL(true, error.c_str());
+            }
+            *data = *contents;
+            *length = contents.length();
+            if (pins) pins->push_back(val);
+            return true;
+        }
+
+        bool ParseMatrix(Local<Value> val, std::vector<Local<Value> >* pins) {
+            V8CHECKBOOL(!val->IsObject(), "matrix: should be an object");
+            Local<Object> matrix = val->ToObject();
+            Local<Value> fmt = Field(matrix, "format");
+            V8CHECKBOOL(!fmt->IsString(), "matrix.format: should be a string");
+            std::string f = V8TOCSTRING(fmt);
+            if (f == "csr" || f == "csc") {
+                format = (f == "csr") ? CSR : CSC;
+                int major = (format == CSR) ? rows : cols;
+                if (!ArrayField(matrix, "start", &Value::IsInt32Array, "Int32Array", major + 1, &start, &startLen, pins)
+                    || !ArrayField(matrix, "index", &Value::IsInt32Array, "Int32Array", 0, &index, &indexLen, pins)
+                    || !ArrayField(matrix, "value", &Value::IsFloat64Array, "Float64Array", 0, &value, &valueLen, pins))
+                    return false;
+                V8CHECKBOOL(!start || !index || !value, "matrix: start, index and value are required");
+            } else if (f == "coo") {
+                format = COO;
+                size_t jaLen = 0;
+                if (!ArrayField(matrix, "ia", &Value::IsInt32Array, "Int32Array", 0, &ia, &indexLen, pins)
+                    || !ArrayField(matrix, "ja", &Value::IsInt32Array, "Int32Array", 0, &ja, &jaLen, pins)
+                    || !ArrayField(matrix, "ar", &Value::IsFloat64Array, "Float64Array", 0, &value, &valueLen, pins))
+                    return false;
+                V8CHECKBOOL(!ia || !ja || !value, "matrix: ia, ja and ar are required");
+                V8CHECKBOOL(indexLen != jaLen || indexLen != valueLen, "the arrays must have the same length");
+                Local<Value> count = Field(matrix, "ne");
+                if (count->IsUndefined()) {
+                    ne = (int)indexLen - 1;
+                } else {
+                    V8CHECKBOOL(!count->IsInt32(), "matrix.ne: should be int32");
+                    ne = count->Int32Value();
+                    V8CHECKBOOL(ne < 0 || (size_t)ne >= indexLen, "matrix.ne: Invalid number of elements");
+                }
+            } else {
+                V8CHECKBOOL(true, "matrix.format: should be 'csr', 'csc' or 'coo'");
+            }
+            return true;
+        }
+
+        static bool ParseNames(Local<Object> names, const char* key, int count,
+                               std::vector<std::pair<int, std::string> >& out) {
+            Local<Value> val = Field(names, key);
+            if (val->IsUndefined() || val->IsNull()) return true;
+            if (!val->IsArray()) {
+                std::string error("names.");
+                error += key;
+                error += ": should be an Array";
+                V8CHECKBOOL(true, error.c_str());
+            }
+            Local<Array> arr = Local<Array>::Cast(val);
+            if (arr->Length() > (uint32_t)count + 1) {
+                std::string error("names.");
+                error += key;
+                error += ": Invalid Array size";
+                V8CHECKBOOL(true, error.c_str());
+            }
+            for (uint32_t k = 1; k < arr->Length(); k++) {
+                Local<Value> s = arr->Get(k);
+                if (s->IsUndefined() || s->IsNull()) continue;
+                if (!s->IsString()) {
+                    std::string error("names.");
+                    error += key;
+                    V8CHECKBOOL(true, Message(error.c_str(), (int)k, "should be a string").c_str());
+                }
+                out.push_back(std::make_pair((int)k, std::string(V8TOCSTRING(s))));
+            }
+            return true;
+        }
+
+        static bool ParseBounds(Local<Object> bounds, const char* key, int count, const int** type,
+                                const double** lb, const double** ub, std::vector<Local<Value> >* pins) {
+            Local<Value> val = Field(bounds, key);
+            if (val->IsUndefined() || val->IsNull()) return true;
+            V8CHECKBOOL(!val->IsObject(), "bounds: rows and cols should be objects");
+            Local<Object> obj = val->ToObject();
+            size_t len;
+            if (!ArrayField(obj, "type", &Value::IsInt32Array, "Int32Array", count, type, &len, pins)
+                || !ArrayField(obj, "lb", &Value::IsFloat64Array, "Float64Array", count, lb, &len, pins)
+                || !ArrayField(obj, "ub", &Value::IsFloat64Array, "Float64Array", count, ub, &len, pins))
+                return false;
+            V8CHECKBOOL(!*type || !*lb || !*ub, "bounds: type, lb and ub are required");
+            return true;
+        }
+
+        std::string ValidateCompressed(int major, int minor) const {
+            if (start[1] != 1)
+                return Message("matrix.start", 1, "should be 1");
+            for (int k = 1; k <= major; k++)
+                if (start[k + 1] < start[k])
+                    return Message("matrix.start", k + 1, "should not decrease");
+            size_t nnz = (size_t)start[major + 1] - 1;
+            if (nnz >= indexLen || nnz >= valueLen)
+                return "matrix: index and value are shorter than start describes";
+
+            // marks[j] holds the last major line in which minor index j was seen
+            std::vector<int> marks(minor + 1, 0);
+            for (int k = 1; k <= major; k++) {
+                for (int p = start[k]; p < start[k + 1]; p++) {
+                    int j = index[p];
+                    if (j < 1 || j > minor)
+                        return Message("matrix.index", p, "Index out of range");
+                    if (marks[j] == k)
+                        return Message("matrix.index", p, "duplicate indices not allowed");
+                    marks[j] = k;
+                }
+            }
+            return std::string();
+        }
+
+        std::string ValidateCoordinate() const {
+            // bucket the elements by row, then look for repeated columns in each row
+            std::vector<int> ptr(rows + 2, 0);
+            for (int k = 1; k <= ne; k++) {
+                if (ia[k] < 1 || ia[k] > rows)
+                    return Message("matrix.ia", k, "Index out of range");
+                if (ja[k] < 1 || ja[k] > cols)
+                    return Message("matrix.ja", k, "Index out of range");
+                ptr[ia[k]]++;
+            }
+            for (int i = 1; i <= rows + 1; i++) ptr[i] += ptr[i - 1];
+            std::vector<int> order(ne > 0 ? ne : 1);
+            for (int k = ne; k >= 1; k--) order[--ptr[ia[k]]] = k;
+            std::vector<int> marks(cols + 1, 0);
+            for (int i = 1; i <= rows; i++) {
+                for (int p = ptr[i]; p < ptr[i + 1]; p++) {
+                    int k = order[p];
+                    if (marks[ja[k]] == i)
+                        return Message("matrix.ja", k, "duplicate indices not allowed");
+                    marks[ja[k]] = i;
+                }
+            }
+            return std::string();
+        }
+
+    public:
+        std::string name;
+        bool hasName;
+        int objDir, rows, cols;
+        Format format;
+        const int *start, *index;
+        const double *value;
+        size_t startLen, indexLen, valueLen;
+        int ne;
+        const int *ia, *ja;
+        std::vector<std::pair<int, std::string> > rowNames, colNames;
+        const int *rowType, *colType;
+        const double *rowLb, *rowUb, *colLb, *colUb;
+        const double *obj;
+        const int *kinds;
+    };
+}
+
+#endif
@@ -281,14 +281,10 @@ static inline int environ_state_unlock(glp_environ_state_t* env_state)
 }
 
 /**
- * Reentrant and threadsafe function for migrating all environment data from the thread-local environment to the given env_state 
- * Call this whenever a thread terminates to ensure all thread-local state is preserved.
+ * Move the memory blocks and counters of the thread-local environment env to env_state
  */
-void glp_env_tls_finalize_r(glp_environ_state_t* env_state)
+static void env_tls_migrate(ENV *env, glp_environ_state_t* env_state)
 {
-    ENV *env = tls_get_ptr();
-    if(env == NULL) return;
-
     /* Outside of the critical section, find the end of this thread's
      * linked list; because last_node was set from tail_ptr, last_node->next
      * *should* be NULL, but just in case */
@@ -329,9 +325,37 @@ void glp_env_tls_finalize_r(glp_environ_state_t* env_state)
     }
     xassert(environ_state_unlock(env_state) == 0);
     env->mem_ptr = NULL;
+}
+
+/**
+ * Reentrant and threadsafe function for migrating all environment data from the thread-local environment to the given env_state 
+ * Call this whenever a thread terminates to ensure all thread-local state is preserved.
+ */
+void glp_env_tls_finalize_r(glp_environ_state_t* env_state)
+{
+    ENV *env = tls_get_ptr();
+    if(env == NULL) return;
+    env_tls_migrate(env, env_state);
     glp_free_env();
 }
 
+/**
+ * Same as glp_env_tls_finalize_r, but the thread-local environment stays allocated so that the
+ * next glp_env_tls_init_r on this thread reuses it. The thread must call glp_free_env when done.
+ */
+void glp_env_tls_release_r(glp_environ_state_t* env_state)
+{
+    ENV *env = tls_get_ptr();
+    if(env == NULL) return;
+    env_tls_migrate(env, env_state);
+    env->mem_count_tls = env->mem_cpeak_tls = 0;
+    env->mem_total_tls = env->mem_tpeak_tls = 0;
+    /* borrowed from env_state, must not be closed with this env */
+    env->tee_file = NULL;
+    env->term_info = NULL;
+    env->env_tls_init_flag = 0;
+}
+
 /**
  * This initializes thread-local storage from a given env_state and info.
  * @param[in] env_state - environment to intialize TLS from
@@ -315,6 +315,12 @@ void glp_free_env_state(glp_environ_state_t *env_state);
 void glp_env_tls_finalize_r(glp_environ_state_t* env_state);
 void glp_env_tls_init_r(glp_environ_state_t* env_state, void* info);
 
+/**
+ * Like glp_env_tls_finalize_r, but keeps the thread-local environment for the next problem handled
+ * by the same thread, which must call glp_free_env once it is done.
+ */
+void glp_env_tls_release_r(glp_environ_state_t* env_state);
+
 #endif
 
 typedef struct glp_file glp_file;
@@ -1499,6 +1499,70 @@ void glp_copy_prob(glp_prob *dest, glp_prob *prob, int names)
       return;
 }
 
+/***********************************************************************
+*  NAME
+*
+*  glp_copy_sol - copy solution from another problem object
+*
+*  SYNOPSIS
+*
+*  void glp_copy_sol(glp_prob *dest, glp_prob *prob, int sol);
+*
+*  DESCRIPTION
+*
+*  The routine glp_copy_sol copies the basic solution and basis
+*  (sol = GLP_SOL) or the interior-point solution (sol = GLP_IPT) of
+*  the problem object prob to the problem object dest, which must have
+*  the same number of rows and columns, e.g. because it was copied with
+*  glp_copy_prob. Iterations performed on prob are added to the
+*  iteration count of dest. */
+
+void glp_copy_sol(glp_prob *dest, glp_prob *prob, int sol)
+{     glp_tree *tree = dest->tree;
+      int i, j;
+      if (tree != NULL && tree->reason != 0)
+         xerror("glp_copy_sol: operation not allowed\n");
+      if (dest == prob)
+         xerror("glp_copy_sol: copying solution to itself not allowed"
+            "\n");
+      if (!(dest->m == prob->m && dest->n == prob->n))
+         xerror("glp_copy_sol: problem dimensions mismatch\n");
+      if (!(sol == GLP_SOL || sol == GLP_IPT))
+         xerror("glp_copy_sol: sol = %d; invalid parameter\n", sol);
+      if (sol == GLP_SOL)
+      {  /* the basis changes, so does its factorization */
+         dest->valid = 0;
+         dest->pbs_stat = prob->pbs_stat;
+         dest->dbs_stat = prob->dbs_stat;
+         dest->obj_val = prob->obj_val;
+         dest->some = prob->some;
+         for (i = 1; i <= prob->m; i++)
+         {  dest->row[i]->stat = prob->row[i]->stat;
+            dest->row[i]->prim = prob->row[i]->prim;
+            dest->row[i]->dual = prob->row[i]->dual;
+         }
+         for (j = 1; j <= prob->n; j++)
+         {  dest->col[j]->stat = prob->col[j]->stat;
+            dest->col[j]->prim = prob->col[j]->prim;
+            dest->col[j]->dual = prob->col[j]->dual;
+         }
+      }
+      else
+      {  dest->ipt_stat = prob->ipt_stat;
+         dest->ipt_obj = prob->ipt_obj;
+         for (i = 1; i <= prob->m; i++)
+         {  dest->row[i]->pval = prob->row[i]->pval;
+            dest->row[i]->dval = prob->row[i]->dval;
+         }
+         for (j = 1; j <= prob->n; j++)
+         {  dest->col[j]->pval = prob->col[j]->pval;
+            dest->col[j]->dval = prob->col[j]->dval;
+         }
+      }
+      dest->it_cnt += prob->it_cnt;
+      return;
+}
+
 /***********************************************************************
 *  NAME
 *
@@ -30,6 +30,9 @@
 #else
 #include "simplex.h"
 #define spx_dual spy_dual
+#define spx_dual_start spy_dual_start
+#define spx_dual_run spy_dual_run
+#define spx_dual_stop spy_dual_stop
 #endif
 
 /***********************************************************************
@@ -102,6 +105,10 @@
 *     The search was prematurely terminated, because the time limit has
 *     been exceeded.
 *
+*  GLP_ECANCEL
+*     The search was prematurely terminated, because the application
+*     set the flag which parm->abort points to.
+*
 *  GLP_ENOPFS
 *     The LP problem instance has no primal feasible solution (only if
 *     the LP presolver is used).
@@ -220,8 +227,10 @@ up:         col->stat = GLP_NU, col->prim = col->ub;
       return;
 }
 
-static int solve_lp(glp_prob *P, const glp_smcp *parm)
-{     /* solve LP directly without using the preprocessor */
+static int start_search(glp_smx_ctx *ctx, glp_prob *P)
+{     /* start the search on the problem without using the
+       * preprocessor; the search is performed by glp_simplex_run */
+      const glp_smcp *parm = ctx->parm;
       int ret;
       if (!glp_bf_exists(P))
       {  ret = glp_factorize(P);
@@ -244,22 +253,73 @@ static int solve_lp(glp_prob *P, const glp_smcp *parm)
             xassert(ret != ret);
          if (ret != 0) goto done;
       }
+      ctx->lp = P;
       if (parm->meth == GLP_PRIMAL)
-         ret = spx_primal(P, parm);
-      else if (parm->meth == GLP_DUALP)
-      {  ret = spx_dual(P, parm);
-         if (ret == GLP_EFAIL && P->valid)
-            ret = spx_primal(P, parm);
+      {  ctx->meth = GLP_PRIMAL;
+         ctx->wksp = spx_primal_start(P, parm);
+      }
+      else if (parm->meth == GLP_DUALP || parm->meth == GLP_DUAL)
+      {  ctx->meth = GLP_DUAL;
+         ctx->wksp = spx_dual_start(P, parm);
       }
-      else if (parm->meth == GLP_DUAL)
-         ret = spx_dual(P, parm);
       else
          xassert(parm != parm);
+      ret = 0;
 done: return ret;
 }
 
-static int preprocess_and_solve_lp(glp_prob *P, const glp_smcp *parm)
-{     /* solve LP using the preprocessor */
+static void finish_search(glp_smx_ctx *ctx, int ret)
+{     /* store the results of the search to the original problem */
+      const glp_smcp *parm = ctx->parm;
+      glp_prob *P = ctx->P;
+      glp_prob *lp = ctx->lp;
+      NPP *npp = ctx->npp;
+      if (npp == NULL)
+         goto done;
+      /* the transformed LP has been solved, if it exists */
+      if (lp == NULL)
+         goto free;
+      if (lp->m == 0 && lp->n == 0)
+         goto post;
+      P->it_cnt = lp->it_cnt;
+      /* only optimal solution can be postprocessed */
+      if (!(ret == 0 && lp->pbs_stat == GLP_FEAS && lp->dbs_stat ==
+            GLP_FEAS))
+      {  if (parm->msg_lev >= GLP_MSG_ERR)
+            xprintf("glp_simplex: unable to recover undefined or non-op"
+               "timal solution\n");
+         if (ret == 0)
+         {  if (lp->pbs_stat == GLP_NOFEAS)
+               ret = GLP_ENOPFS;
+            else if (lp->dbs_stat == GLP_NOFEAS)
+               ret = GLP_ENODFS;
+            else
+               xassert(lp != lp);
+         }
+         goto free;
+      }
+post: /* postprocess solution from the transformed LP */
+      npp_postprocess(npp, lp);
+      /* the transformed LP is no longer needed */
+      glp_delete_prob(lp), lp = NULL;
+      /* store solution to the original problem */
+      npp_unload_sol(npp, P);
+      /* the original LP has been successfully solved */
+      ret = 0;
+free: /* delete the transformed LP, if it exists */
+      if (lp != NULL) glp_delete_prob(lp);
+      /* delete preprocessor workspace */
+      npp_delete_wksp(npp);
+      ctx->npp = NULL;
+done: ctx->lp = NULL;
+      ctx->ret = ret;
+      ctx->done = 1;
+      return;
+}
+
+static void preprocess_and_start(glp_smx_ctx *ctx, glp_prob *P)
+{     /* start the search using the preprocessor */
+      const glp_smcp *parm = ctx->parm;
       NPP *npp;
       glp_prob *lp = NULL;
       glp_bfcp bfcp;
@@ -267,7 +327,7 @@ static int preprocess_and_solve_lp(glp_prob *P, const glp_smcp *parm)
       if (parm->msg_lev >= GLP_MSG_ALL)
          xprintf("Preprocessing...\n");
       /* create preprocessor workspace */
-      npp = npp_create_wksp();
+      ctx->npp = npp = npp_create_wksp();
       /* load original problem into the preprocessor workspace */
       npp_load_prob(npp, P, GLP_OFF, GLP_SOL, GLP_OFF);
       /* process LP prior to applying primal/dual simplex method */
@@ -286,7 +346,7 @@ static int preprocess_and_solve_lp(glp_prob *P, const glp_smcp *parm)
          xassert(ret != ret);
       if (ret != 0) goto done;
       /* build transformed LP */
-      lp = glp_create_prob();
+      ctx->lp = lp = glp_create_prob();
       npp_build_prob(npp, lp);
       /* if the transformed LP is empty, it has empty solution, which
          is optimal */
@@ -299,7 +359,7 @@ static int preprocess_and_solve_lp(glp_prob *P, const glp_smcp *parm)
          }
          if (parm->msg_lev >= GLP_MSG_ALL)
             xprintf("OPTIMAL SOLUTION FOUND BY LP PREPROCESSOR\n");
-         goto post;
+         goto done;
       }
       if (parm->msg_lev >= GLP_MSG_ALL)
       {  xprintf("%d row%s, %d column%s, %d non-zero%s\n",
@@ -334,53 +394,21 @@ static int preprocess_and_solve_lp(glp_prob *P, const glp_smcp *parm)
       glp_scale_prob(lp, GLP_SF_AUTO);
       glp_adv_basis(lp, 0);
 #endif
-      /* solve the transformed LP */
+      /* start to solve the transformed LP */
       lp->it_cnt = P->it_cnt;
-      ret = solve_lp(lp, parm);
-      P->it_cnt = lp->it_cnt;
-      /* only optimal solution can be postprocessed */
-      if (!(ret == 0 && lp->pbs_stat == GLP_FEAS && lp->dbs_stat ==
-            GLP_FEAS))
-      {  if (parm->msg_lev >= GLP_MSG_ERR)
-            xprintf("glp_simplex: unable to recover undefined or non-op"
-               "timal solution\n");
-         if (ret == 0)
-         {  if (lp->pbs_stat == GLP_NOFEAS)
-               ret = GLP_ENOPFS;
-            else if (lp->dbs_stat == GLP_NOFEAS)
-               ret = GLP_ENODFS;
-            else
-               xassert(lp != lp);
-         }
-         goto done;
-      }
-post: /* postprocess solution from the transformed LP */
-      npp_postprocess(npp, lp);
-      /* the transformed LP is no longer needed */
-      glp_delete_prob(lp), lp = NULL;
-      /* store solution to the original problem */
-      npp_unload_sol(npp, P);
-      /* the original LP has been successfully solved */
-      ret = 0;
-done: /* delete the transformed LP, if it exists */
-      if (lp != NULL) glp_delete_prob(lp);
-      /* delete preprocessor workspace */
-      npp_delete_wksp(npp);
-      return ret;
+      ret = start_search(ctx, lp);
+      if (ret == 0)
+         return;
+done: finish_search(ctx, ret);
+      return;
 }
 
-int glp_simplex(glp_prob *P, const glp_smcp *parm)
-{     /* solve LP problem with the simplex method */
-      glp_smcp _parm;
-      int i, j, ret;
-      /* check problem object */
+static void check_parm(glp_prob *P, const glp_smcp *parm)
+{     /* check problem object and control parameters */
       if (P == NULL || P->magic != GLP_PROB_MAGIC)
          xerror("glp_simplex: P = %p; invalid problem object\n", P);
       if (P->tree != NULL && P->tree->reason != 0)
          xerror("glp_simplex: operation not allowed\n");
-      /* check control parameters */
-      if (parm == NULL)
-         parm = &_parm, glp_init_smcp((glp_smcp *)parm);
       if (!(parm->msg_lev == GLP_MSG_OFF ||
             parm->msg_lev == GLP_MSG_ERR ||
             parm->msg_lev == GLP_MSG_ON  ||
@@ -390,7 +418,8 @@ int glp_simplex(glp_prob *P, const glp_smcp *parm)
             parm->msg_lev);
       if (!(parm->meth == GLP_PRIMAL ||
             parm->meth == GLP_DUALP  ||
-            parm->meth == GLP_DUAL))
+            parm->meth == GLP_DUAL   ||
+            parm->meth == GLP_SIFTING))
          xerror("glp_simplex: meth = %d; invalid parameter\n",
             parm->meth);
       if (!(parm->pricing == GLP_PT_STD ||
@@ -398,7 +427,8 @@ int glp_simplex(glp_prob *P, const glp_smcp *parm)
          xerror("glp_simplex: pricing = %d; invalid parameter\n",
             parm->pricing);
       if (!(parm->r_test == GLP_RT_STD ||
-            parm->r_test == GLP_RT_HAR))
+            parm->r_test == GLP_RT_HAR ||
+            parm->r_test == GLP_RT_FLIP))
          xerror("glp_simplex: r_test = %d; invalid parameter\n",
             parm->r_test);
       if (!(0.0 < parm->tol_bnd && parm->tol_bnd < 1.0))
@@ -425,6 +455,98 @@ int glp_simplex(glp_prob *P, const glp_smcp *parm)
       if (!(parm->presolve == GLP_ON || parm->presolve == GLP_OFF))
          xerror("glp_simplex: presolve = %d; invalid parameter\n",
             parm->presolve);
+      if (!(parm->simd == GLP_ON || parm->simd == GLP_OFF))
+         xerror("glp_simplex: simd = %d; invalid parameter\n",
+            parm->simd);
+      if (parm->part_len < 0)
+         xerror("glp_simplex: part_len = %d; invalid parameter\n",
+            parm->part_len);
+      return;
+}
+
+int glp_simplex(glp_prob *P, const glp_smcp *parm)
+{     /* solve LP problem with the simplex method */
+      glp_smcp _parm;
+      glp_smx_ctx ctx;
+      if (parm == NULL)
+         parm = &_parm, glp_init_smcp((glp_smcp *)parm);
+      if (parm->meth == GLP_SIFTING)
+      {  check_parm(P, parm);
+         return spx_sifting(P, parm);
+      }
+      glp_init_smx_ctx(&ctx);
+      ctx.parm = parm;
+      glp_simplex_start(P, &ctx);
+      while (!ctx.done)
+         glp_simplex_run(&ctx, 0, 0);
+      glp_simplex_stop(P, &ctx);
+      return ctx.ret;
+}
+
+/***********************************************************************
+*  NAME
+*
+*  glp_simplex_start - start solving LP problem with the simplex method
+*  glp_simplex_run   - continue the search for a limited time
+*  glp_simplex_stop  - finish the search
+*
+*  SYNOPSIS
+*
+*  void glp_init_smx_ctx(glp_smx_ctx *ctx);
+*  void glp_simplex_start(glp_prob *P, glp_smx_ctx *ctx);
+*  void glp_simplex_run(glp_smx_ctx *ctx, int it_lim, int tm_lim);
+*  void glp_simplex_stop(glp_prob *P, glp_smx_ctx *ctx);
+*
+*  DESCRIPTION
+*
+*  These routines split glp_simplex, so that the search can be
+*  suspended and continued later, possibly on another thread, while
+*  the working LP, the basis factorization and the pricing data are
+*  kept in the context ctx. ctx->parm must point to the control
+*  parameters, which have to stay valid until glp_simplex_stop.
+*
+*  glp_simplex_start checks the problem, runs the preprocessor, if
+*  required, and prepares the search. glp_simplex_run continues the
+*  search for at most it_lim simplex iterations and tm_lim milliseconds
+*  (0 means no limit), at least one iteration is performed each time.
+*  ctx->it_cnt is the simplex iteration count reached so far. Once
+*  ctx->done is set, the search is finished, ctx->ret contains the
+*  code that glp_simplex would return and the solution is stored in
+*  the problem object.
+*
+*  glp_simplex_stop must be called in any case to free the context. If
+*  the search has not been finished, it is abandoned: the problem
+*  object keeps its initial basis, the basic solution is undefined and
+*  ctx->ret is set to GLP_ECANCEL.
+*
+*  The problem object must not be used by the application until
+*  glp_simplex_stop has been called. */
+
+void glp_init_smx_ctx(glp_smx_ctx *ctx)
+{     ctx->ret = 0;
+      ctx->done = 0;
+      ctx->parm = NULL;
+      ctx->P = NULL;
+      ctx->lp = NULL;
+      ctx->npp = NULL;
+      ctx->wksp = NULL;
+      ctx->meth = 0;
+      ctx->it_cnt = 0;
+      return;
+}
+
+void glp_simplex_start(glp_prob *P, glp_smx_ctx *ctx)
+{     const glp_smcp *parm = ctx->parm;
+      int i, j, ret;
+      if (parm == NULL)
+         xerror("glp_simplex_start: parm = %p; invalid parameter\n",
+            parm);
+      check_parm(P, parm);
+      if (parm->meth == GLP_SIFTING)
+         xerror("glp_simplex_start: meth = %d; sifting not supported\n",
+            parm->meth);
+      ctx->P = P;
+      ctx->it_cnt = P->it_cnt;
       /* basic solution is currently undefined */
       P->pbs_stat = P->dbs_stat = GLP_UNDEF;
       P->obj_val = 0.0;
@@ -460,11 +582,64 @@ int glp_simplex(glp_prob *P, const glp_smcp *parm)
       if (P->nnz == 0)
          trivial_lp(P, parm), ret = 0;
       else if (!parm->presolve)
-         ret = solve_lp(P, parm);
+      {  ret = start_search(ctx, P);
+         if (ret == 0)
+            return;
+      }
+      else
+      {  preprocess_and_start(ctx, P);
+         return;
+      }
+done: finish_search(ctx, ret);
+      return;
+}
+
+void glp_simplex_run(glp_smx_ctx *ctx, int it_lim, int tm_lim)
+{     const glp_smcp *parm = ctx->parm;
+      int ret;
+      if (ctx->done)
+         return;
+      xassert(ctx->wksp != NULL);
+      if (it_lim < 0)
+         xerror("glp_simplex_run: it_lim = %d; invalid parameter\n",
+            it_lim);
+      if (tm_lim < 0)
+         xerror("glp_simplex_run: tm_lim = %d; invalid parameter\n",
+            tm_lim);
+      if (ctx->meth == GLP_PRIMAL)
+         ret = spx_primal_run(ctx->wksp, it_lim, tm_lim, &ctx->it_cnt);
       else
-         ret = preprocess_and_solve_lp(P, parm);
-done: /* return to the application program */
-      return ret;
+         ret = spx_dual_run(ctx->wksp, it_lim, tm_lim, &ctx->it_cnt);
+      if (ret == SPX_YIELD)
+         return;
+      if (ctx->meth == GLP_PRIMAL)
+         ret = spx_primal_stop(ctx->wksp);
+      else
+         ret = spx_dual_stop(ctx->wksp);
+      ctx->wksp = NULL;
+      /* the dual simplex failed, switch to the primal simplex */
+      if (parm->meth == GLP_DUALP && ctx->meth == GLP_DUAL &&
+          ret == GLP_EFAIL && ctx->lp->valid)
+      {  ctx->meth = GLP_PRIMAL;
+         ctx->wksp = spx_primal_start(ctx->lp, parm);
+         return;
+      }
+      finish_search(ctx, ret);
+      return;
+}
+
+void glp_simplex_stop(glp_prob *P, glp_smx_ctx *ctx)
+{     xassert(P == ctx->P);
+      if (ctx->done)
+         return;
+      /* abandon the search */
+      if (ctx->meth == GLP_PRIMAL)
+         spx_primal_stop(ctx->wksp);
+      else
+         spx_dual_stop(ctx->wksp);
+      ctx->wksp = NULL;
+      finish_search(ctx, GLP_ECANCEL);
+      return;
 }
 
 /***********************************************************************
@@ -503,6 +678,9 @@ void glp_init_smcp(glp_smcp *parm)
       parm->out_frq = 500;
       parm->out_dly = 0;
       parm->presolve = GLP_OFF;
+      parm->simd = GLP_ON;
+      parm->part_len = 0;
+      parm->abort = NULL;
       return;
 }
 
@@ -45,8 +45,8 @@
 *  in mathematical sense, i.e. free of round-off errors unlike floating
 *  point arithmetic.
 *
-*  Note that the routine glp_exact uses inly two control parameters
-*  passed in the structure glp_smcp, namely, it_lim and tm_lim.
+*  Note that the routine glp_exact uses only three control parameters
+*  passed in the structure glp_smcp, namely, it_lim, tm_lim and abort.
 *
 *  RETURNS
 *
@@ -77,7 +77,11 @@
 *
 *  GLP_ETMLIM
 *     The search was prematurely terminated, because the time limit has
-*     been exceeded. */
+*     been exceeded.
+*
+*  GLP_ECANCEL
+*     The search was prematurely terminated, because the application
+*     set the flag which parm->abort points to. */
 
 static void set_d_eps(mpq_t x, double val)
 {     /* convert double val to rational x obtaining a more adequate
@@ -330,6 +334,7 @@ int glp_exact(glp_prob *lp, const glp_smcp *parm)
       ssx->it_lim = parm->it_lim;
       ssx->it_cnt = lp->it_cnt;
       ssx->tm_lim = (double)parm->tm_lim / 1000.0;
+      ssx->abort = parm->abort;
 #endif
       ssx->out_frq = 5.0;
       ssx->tm_beg = xtime();
@@ -394,6 +399,16 @@ int glp_exact(glp_prob *lp, const glp_smcp *parm)
             /* initial basis matrix is singular */
             ret = GLP_ESING;
             goto done;
+         case 8:
+            /* search cancelled (phase I) */
+            ret = GLP_ECANCEL;
+            pst = dst = GLP_INFEAS;
+            break;
+         case 9:
+            /* search cancelled (phase II) */
+            ret = GLP_ECANCEL;
+            pst = GLP_FEAS, dst = GLP_INFEAS;
+            break;
          default:
             xassert(ret != ret);
       }
@@ -67,7 +67,10 @@
 *     Iteration limit exceeded.
 *
 *  GLP_EINSTAB
-*     Numerical instability on solving Newtonian system. */
+*     Numerical instability on solving Newtonian system.
+*
+*  GLP_ECANCEL
+*     The search was cancelled by the application. */
 
 static void transform(NPP *npp)
 {     /* transform LP to the standard formulation */
@@ -240,6 +243,7 @@ done: /* free working program objects */
 void glp_init_iptcp(glp_iptcp *parm)
 {     parm->msg_lev = GLP_MSG_ALL;
       parm->ord_alg = GLP_ORD_AMD;
+      parm->abort = NULL;
       return;
 }
 
@@ -526,7 +526,8 @@ void glp_intopt_start(glp_prob *P, glp_mip_ctx *ctx)
             parm->br_tech == GLP_BR_LFV ||
             parm->br_tech == GLP_BR_MFV ||
             parm->br_tech == GLP_BR_DTH ||
-            parm->br_tech == GLP_BR_PCH))
+            parm->br_tech == GLP_BR_PCH ||
+            parm->br_tech == GLP_BR_RLB))
          xerror("glp_intopt: br_tech = %d; invalid parameter\n",
             parm->br_tech);
       if (!(parm->bt_tech == GLP_BT_DFS ||
@@ -582,6 +583,20 @@ void glp_intopt_start(glp_prob *P, glp_mip_ctx *ctx)
       if (!(parm->fp_heur == GLP_ON || parm->fp_heur == GLP_OFF))
          xerror("glp_intopt: fp_heur = %d; invalid parameter\n",
             parm->fp_heur);
+      if (!(parm->par_cuts == GLP_ON || parm->par_cuts == GLP_OFF))
+         xerror("glp_intopt: par_cuts = %d; invalid parameter\n",
+            parm->par_cuts);
+      if (parm->br_tech == GLP_BR_RLB)
+      {  if (parm->rb_rel < 1)
+            xerror("glp_intopt: rb_rel = %d; invalid parameter\n",
+               parm->rb_rel);
+         if (parm->rb_it_lim < 1)
+            xerror("glp_intopt: rb_it_lim = %d; invalid parameter\n",
+               parm->rb_it_lim);
+         if (parm->rb_threads < 0)
+            xerror("glp_intopt: rb_threads = %d; invalid parameter\n",
+               parm->rb_threads);
+      }
 #if 1 /* 28/V-2010 */
       if (!(parm->alien == GLP_ON || parm->alien == GLP_OFF))
          xerror("glp_intopt: alien = %d; invalid parameter\n",
@@ -772,6 +787,13 @@ void glp_init_iocp(glp_iocp *parm)
       parm->ps_heur = GLP_OFF;
       parm->ps_tm_lim = 60000; /* 1 minute */
       parm->sr_heur = GLP_ON;
+      parm->threads = 1;
+      parm->par_det = GLP_OFF;
+      parm->par_seed = 1;
+      parm->rb_rel = 4;
+      parm->rb_it_lim = 30;
+      parm->rb_threads = 0;
+      parm->par_cuts = GLP_OFF;
 #if 1 /* 24/X-2015; not documented--should not be used */
       parm->use_sol = GLP_OFF;
       parm->save_sol = NULL;
@@ -879,4 +901,51 @@ double glp_mip_col_val(glp_prob *mip, int j)
       return mipx;
 }
 
+/***********************************************************************
+*  NAME
+*
+*  glp_put_mip_sol - store MIP solution found elsewhere
+*
+*  SYNOPSIS
+*
+*  void glp_put_mip_sol(glp_prob *mip, int stat, const double x[]);
+*
+*  DESCRIPTION
+*
+*  The routine glp_put_mip_sol stores the status stat (GLP_UNDEF,
+*  GLP_OPT, GLP_FEAS or GLP_NOFEAS) of the MIP solution of the problem
+*  object mip, e.g. of a search done on copies of it. If stat is GLP_OPT
+*  or GLP_FEAS, x[1], ..., x[n] are the values of the columns, from
+*  which the values of the rows and of the objective are computed;
+*  otherwise x is not used and may be NULL. The values are not checked
+*  for feasibility. */
+
+void glp_put_mip_sol(glp_prob *mip, int stat, const double x[])
+{     GLPAIJ *aij;
+      int i, j;
+      double sum;
+      if (mip->tree != NULL)
+         xerror("glp_put_mip_sol: operation not allowed\n");
+      if (!(stat == GLP_UNDEF || stat == GLP_OPT || stat == GLP_FEAS ||
+            stat == GLP_NOFEAS))
+         xerror("glp_put_mip_sol: stat = %d; invalid parameter\n",
+            stat);
+      mip->mip_stat = stat;
+      if (!(stat == GLP_OPT || stat == GLP_FEAS))
+         return;
+      sum = mip->c0;
+      for (j = 1; j <= mip->n; j++)
+      {  mip->col[j]->mipx = x[j];
+         sum += mip->col[j]->coef * x[j];
+      }
+      mip->mip_obj = sum;
+      for (i = 1; i <= mip->m; i++)
+      {  sum = 0.0;
+         for (aij = mip->row[i]->ptr; aij != NULL; aij = aij->r_next)
+            sum += aij->val * aij->col->mipx;
+         mip->row[i]->mipx = sum;
+      }
+      return;
+}
+
 /* eof */
@@ -598,6 +598,10 @@ void ios_pcost_update(glp_tree *tree);
 void ios_pcost_free(glp_tree *tree);
 /* free working area used on pseudocost branching */
 
+#define ios_rel_branch _glp_ios_rel_branch
+int ios_rel_branch(glp_tree *T, int *next);
+/* choose branching variable with reliability branching */
+
 #define ios_feas_pump _glp_ios_feas_pump
 void ios_feas_pump(glp_tree *T);
 /* feasibility pump heuristic */
@@ -696,6 +696,185 @@ done: glp_delete_prob(lp);
 
 /**********************************************************************/
 
+/* cut generators in the order generate_cuts runs them */
+#define SEP_GMI 1
+#define SEP_MIR 2
+#define SEP_COV 3
+#define SEP_CLQ 4
+
+static void separate(glp_tree *T, int k)
+{     /* run cut generator k, which adds its cuts to T->local */
+      switch (k)
+      {  case SEP_GMI:
+            ios_gmi_gen(T);
+            break;
+         case SEP_MIR:
+            xassert(T->mir_gen != NULL);
+            ios_mir_gen(T, T->mir_gen);
+            break;
+         case SEP_COV:
+            ios_cov_gen(T);
+            break;
+         case SEP_CLQ:
+            ios_clq_gen(T, T->clq_gen);
+            break;
+         default:
+            xassert(k != k);
+      }
+      return;
+}
+
+struct sep_sync
+{     /* generators running on their own threads */
+      pthread_mutex_t lock;
+      pthread_cond_t cond;
+      int done;
+      /* number of generators done */
+      int merged;
+      /* their cuts have been taken over */
+};
+
+struct sep_task
+{     /* cut generator running on its own thread */
+      glp_tree S;
+      /* copy of the search, only its memory pool and local cut pool
+         are its own; the generator must not change anything else */
+      int k;
+      /* generator */
+      struct sep_sync *sync;
+      pthread_t tid;
+      int started;
+      int failed;
+      /* the generator has run into an error */
+};
+
+static void sep_error(void *jump)
+{     /* error hook of a cut generator thread */
+      longjmp(*(jmp_buf *)jump, 1);
+      /* no return */
+}
+
+static void *sep_thread(void *arg)
+{     /* run a cut generator in its own environment, whose error hook
+         only records the error, so that the calling thread can raise
+         it (see separate_par) */
+      struct sep_task *task = arg;
+      struct sep_sync *sync = task->sync;
+      jmp_buf jump;
+      glp_term_out(GLP_OFF);
+      if (setjmp(jump))
+      {  /* the environment is left as is and freed below; the cuts
+            are not taken over */
+         pthread_mutex_lock(&sync->lock);
+         if (!sync->merged)
+         {  task->failed = 1;
+            sync->done++;
+            pthread_cond_broadcast(&sync->cond);
+         }
+         pthread_mutex_unlock(&sync->lock);
+         glp_free_env();
+         return NULL;
+      }
+      glp_error_hook(sep_error, &jump);
+      task->S.pool = dmp_create_pool();
+      task->S.local = ios_create_pool(&task->S);
+      separate(&task->S, task->k);
+      /* the cuts live in the environment of this thread, keep it until
+         they have been merged */
+      pthread_mutex_lock(&sync->lock);
+      sync->done++;
+      pthread_cond_broadcast(&sync->cond);
+      while (!sync->merged)
+         pthread_cond_wait(&sync->cond, &sync->lock);
+      pthread_mutex_unlock(&sync->lock);
+      ios_delete_pool(&task->S, task->S.local);
+      dmp_delete_pool(task->S.pool);
+      glp_free_env();
+      return NULL;
+}
+
+static void merge_cuts(glp_tree *T, IOSPOOL *pool, int *ind,
+      double *val)
+{     /* add the cuts of pool to T->local, as the generator would have
+         added them */
+      IOSCUT *cut;
+      IOSAIJ *aij;
+      int len, k;
+      for (cut = pool->head; cut != NULL; cut = cut->next)
+      {  len = 0;
+         for (aij = cut->ptr; aij != NULL; aij = aij->next)
+            len++;
+         /* ios_add_row stores the coefficients in reverse order */
+         k = len;
+         for (aij = cut->ptr; aij != NULL; aij = aij->next, k--)
+            ind[k] = aij->j, val[k] = aij->val;
+         ios_add_row(T, T->local, cut->name, cut->klass, 0, len, ind,
+            val, cut->type, cut->rhs);
+      }
+      return;
+}
+
+static void separate_par(glp_tree *T, const int gen[])
+{     /* run the cut generators flagged in gen concurrently against the
+         current LP solution and merge their cuts in the order of
+         generate_cuts, so that T->local ends up as with the generators
+         run one after another; GMI, the only one using the basis
+         factorization, runs on the calling thread */
+      struct sep_sync sync;
+      struct sep_task task[1+SEP_CLQ];
+      int k, started = 0, failed = 0, *ind;
+      double *val;
+      pthread_mutex_init(&sync.lock, NULL);
+      pthread_cond_init(&sync.cond, NULL);
+      sync.done = sync.merged = 0;
+      for (k = SEP_MIR; k <= SEP_CLQ; k++)
+      {  task[k].started = task[k].failed = 0;
+         if (!gen[k]) continue;
+         task[k].S = *T;
+         task[k].k = k;
+         task[k].sync = &sync;
+         /* on failure the generator is run by the calling thread */
+         if (pthread_create(&task[k].tid, NULL, sep_thread, &task[k])
+            == 0)
+            task[k].started = 1, started++;
+      }
+      if (gen[SEP_GMI])
+         separate(T, SEP_GMI);
+      pthread_mutex_lock(&sync.lock);
+      while (sync.done < started)
+         pthread_cond_wait(&sync.cond, &sync.lock);
+      pthread_mutex_unlock(&sync.lock);
+      for (k = SEP_MIR; k <= SEP_CLQ; k++)
+         failed |= task[k].failed;
+      if (!failed)
+      {  ind = xcalloc(1+T->n, sizeof(int));
+         val = xcalloc(1+T->n, sizeof(double));
+         for (k = SEP_MIR; k <= SEP_CLQ; k++)
+         {  if (task[k].started)
+               merge_cuts(T, task[k].S.local, ind, val);
+            else if (gen[k])
+               separate(T, k);
+         }
+         xfree(ind);
+         xfree(val);
+      }
+      pthread_mutex_lock(&sync.lock);
+      sync.merged = 1;
+      pthread_cond_broadcast(&sync.cond);
+      pthread_mutex_unlock(&sync.lock);
+      for (k = SEP_MIR; k <= SEP_CLQ; k++)
+         if (task[k].started) pthread_join(task[k].tid, NULL);
+      pthread_cond_destroy(&sync.cond);
+      pthread_mutex_destroy(&sync.lock);
+      /* an error of a generator is raised on this thread, as if it had
+         run the generator itself */
+      if (failed)
+         xerror("generate_cuts: cut generator thread failed\n");
+      return;
+}
+
+/**********************************************************************/
+
 static void generate_cuts(glp_tree *T)
 {     /* generate generic cuts with built-in generators */
       if (!(T->parm->mir_cuts == GLP_ON ||
@@ -716,29 +895,30 @@ static void generate_cuts(glp_tree *T)
       }
 #endif
       /* generate and add to POOL all cuts violated by x* */
-      if (T->parm->gmi_cuts == GLP_ON)
-      {  if (T->curr->changed < 7)
-            ios_gmi_gen(T);
-      }
-      if (T->parm->mir_cuts == GLP_ON)
-      {  xassert(T->mir_gen != NULL);
-         ios_mir_gen(T, T->mir_gen);
-      }
-      if (T->parm->cov_cuts == GLP_ON)
-      {  /* cover cuts works well along with mir cuts */
-         /*if (T->round <= 5)*/
-            ios_cov_gen(T);
-      }
-      if (T->parm->clq_cuts == GLP_ON)
-      {  if (T->clq_gen != NULL)
+      {  int gen[1+SEP_CLQ], k, cnt = 0;
+         gen[SEP_GMI] = (T->parm->gmi_cuts == GLP_ON &&
+            T->curr->changed < 7);
+         gen[SEP_MIR] = (T->parm->mir_cuts == GLP_ON);
+         /* cover cuts works well along with mir cuts */
+         gen[SEP_COV] = (T->parm->cov_cuts == GLP_ON);
 #if 0 /* 29/VI-2013 */
-         {  if (T->curr->level == 0 && T->curr->changed < 50 ||
-                T->curr->level >  0 && T->curr->changed < 5)
+         gen[SEP_CLQ] = (T->parm->clq_cuts == GLP_ON &&
+            T->clq_gen != NULL &&
+           (T->curr->level == 0 && T->curr->changed < 50 ||
+            T->curr->level >  0 && T->curr->changed < 5));
 #else /* FIXME */
-         {  if (T->curr->level == 0 && T->curr->changed < 500 ||
-                T->curr->level >  0 && T->curr->changed < 50)
+         gen[SEP_CLQ] = (T->parm->clq_cuts == GLP_ON &&
+            T->clq_gen != NULL &&
+           (T->curr->level == 0 && T->curr->changed < 500 ||
+            T->curr->level >  0 && T->curr->changed < 50));
 #endif
-               ios_clq_gen(T, T->clq_gen);
+         for (k = SEP_GMI; k <= SEP_CLQ; k++)
+            cnt += gen[k];
+         if (T->parm->par_cuts == GLP_ON && cnt > 1)
+            separate_par(T, gen);
+         else
+         {  for (k = SEP_GMI; k <= SEP_CLQ; k++)
+               if (gen[k]) separate(T, k);
          }
       }
 done: return;
@@ -72,6 +72,10 @@ int ios_choose_var(glp_tree *T, int *next)
       {  /* hybrid pseudocost heuristic */
          j = ios_pcost_branch(T, next);
       }
+      else if (T->parm->br_tech == GLP_BR_RLB)
+      {  /* reliability branching */
+         j = ios_rel_branch(T, next);
+      }
       else
          xassert(T != T);
       return j;
@@ -661,4 +665,305 @@ done: *_next = sel;
       return jjj;
 }
 
+/***********************************************************************
+*  ios_rel_branch - choose branching variable with reliability branching
+*
+*  This routine scores every branching candidate with the product of
+*  the degradations of the objective expected in its down- and up-
+*  branch. The pseudocosts of a candidate are reliable once both have
+*  been observed at least rb_rel times. Degradations of the other
+*  candidates are evaluated with strong branching, i.e. with at most
+*  rb_it_lim dual simplex iterations on a copy of the current LP, which
+*  also initializes or updates their pseudocosts. The unreliable
+*  candidates are evaluated best pseudocost estimate first, up to
+*  rb_threads of them at a time, each thread on its own copy, until
+*  RB_LOOKAHEAD candidates in a row have not improved the best score.
+*  No candidate past that point is evaluated, so that the choice and
+*  the pseudocosts do not depend on the number of threads. */
+
+#define RB_LOOKAHEAD 8
+
+struct rb_cand
+{     /* unreliable candidate */
+      int j;
+      /* column number */
+      double score;
+      /* score estimated with pseudocosts */
+};
+
+struct rb_task
+{     /* strong branching on one candidate */
+      int j;
+      /* column number */
+      double beta;
+      /* value of x[j] in the current LP solution */
+      double dn, up;
+      /* degradation of the objective in the down- and up-branch;
+         DBL_MAX means the branch has no primal feasible solution */
+};
+
+struct rb_pool
+{     /* candidates evaluated at the same time */
+      glp_prob *P;
+      /* LP relaxation of the current subproblem */
+      int it_lim;
+      /* simplex iteration limit */
+      struct rb_task *task; /* struct rb_task task[count]; */
+      int count;
+      int next;
+      /* next task to be taken by a thread */
+      int failed;
+      /* a thread has run into an error */
+      pthread_mutex_t lock;
+};
+
+static double rb_degrad(struct rb_pool *pool, glp_prob *lp, int j,
+      double bnd)
+{     /* evaluate degradation of the objective on fixing x[j] at given
+         value, as eval_degrad does, on the copy lp of the current LP,
+         which is restored afterwards */
+      glp_prob *P = pool->P;
+      glp_smcp parm;
+      int i, k, ret;
+      double degrad = 0.0;
+      glp_set_col_bnds(lp, j, GLP_FX, bnd, bnd);
+      glp_init_smcp(&parm);
+      parm.msg_lev = GLP_MSG_OFF;
+      parm.meth = GLP_DUAL;
+      parm.it_lim = pool->it_lim;
+      parm.out_dly = 1000;
+      ret = glp_simplex(lp, &parm);
+      if (ret == 0 || ret == GLP_EITLIM)
+      {  if (glp_get_prim_stat(lp) == GLP_NOFEAS)
+            degrad = DBL_MAX;
+         else if (glp_get_dual_stat(lp) == GLP_FEAS)
+         {  if (P->dir == GLP_MIN)
+               degrad = lp->obj_val - P->obj_val;
+            else if (P->dir == GLP_MAX)
+               degrad = P->obj_val - lp->obj_val;
+            else
+               xassert(P != P);
+            if (degrad < 1e-6 * (1.0 + 0.001 * fabs(P->obj_val)))
+               degrad = 0.0;
+         }
+         else
+            degrad = 0.0;
+      }
+      else
+         degrad = 0.0;
+      /* restore the bounds of x[j] and the optimal basis */
+      glp_set_col_bnds(lp, j, glp_get_col_type(P, j),
+         glp_get_col_lb(P, j), glp_get_col_ub(P, j));
+      for (i = 1; i <= lp->m; i++)
+         glp_set_row_stat(lp, i, glp_get_row_stat(P, i));
+      for (k = 1; k <= lp->n; k++)
+         glp_set_col_stat(lp, k, glp_get_col_stat(P, k));
+      return degrad;
+}
+
+static void rb_eval(struct rb_pool *pool)
+{     /* take and evaluate tasks of the pool until none is left */
+      glp_prob *lp = NULL;
+      struct rb_task *task;
+      int k;
+      for (;;)
+      {  pthread_mutex_lock(&pool->lock);
+         k = pool->next;
+         if (k < pool->count) pool->next++;
+         pthread_mutex_unlock(&pool->lock);
+         if (k >= pool->count) break;
+         if (lp == NULL)
+         {  lp = glp_create_prob();
+            glp_copy_prob(lp, pool->P, 0);
+         }
+         task = &pool->task[k];
+         task->dn = rb_degrad(pool, lp, task->j, floor(task->beta));
+         task->up = rb_degrad(pool, lp, task->j, ceil(task->beta));
+      }
+      if (lp != NULL) glp_delete_prob(lp);
+      return;
+}
+
+static void rb_error(void *jump)
+{     /* error hook of a strong branching thread */
+      longjmp(*(jmp_buf *)jump, 1);
+      /* no return */
+}
+
+static void *rb_thread(void *_pool)
+{     /* strong branching thread; it has its own environment, whose
+         error hook only records the error, so that the calling thread
+         can raise it (see rb_run) */
+      struct rb_pool *pool = _pool;
+      jmp_buf jump;
+      glp_term_out(GLP_OFF);
+      if (setjmp(jump))
+      {  /* the environment is left as is and freed below */
+         pthread_mutex_lock(&pool->lock);
+         pool->failed = 1;
+         pthread_mutex_unlock(&pool->lock);
+      }
+      else
+      {  glp_error_hook(rb_error, &jump);
+         rb_eval(pool);
+      }
+      glp_free_env();
+      return NULL;
+}
+
+static void rb_run(struct rb_pool *pool, int nthreads)
+{     /* evaluate all tasks of the pool on nthreads threads, the
+         calling one included */
+      pthread_t *tid;
+      int t, started = 0;
+      pool->next = 0;
+      tid = xcalloc(nthreads, sizeof(pthread_t));
+      for (t = 1; t < nthreads && t < pool->count; t++)
+      {  /* on failure the other threads take over */
+         if (pthread_create(&tid[started], NULL, rb_thread, pool) == 0)
+            started++;
+      }
+      rb_eval(pool);
+      for (t = 0; t < started; t++)
+         pthread_join(tid[t], NULL);
+      xfree(tid);
+      /* an error on another thread is raised on this one, as if it
+         had evaluated the task itself */
+      if (pool->failed)
+      {  pthread_mutex_destroy(&pool->lock);
+         xerror("ios_rel_branch: strong branching thread failed\n");
+      }
+      return;
+}
+
+static double rb_score(double d1, double d2)
+{     /* score of a candidate with expected degradations d1 and d2 */
+      return (d1 > 1e-6 ? d1 : 1e-6) * (d2 > 1e-6 ? d2 : 1e-6);
+}
+
+static int rb_cmp(const void *a, const void *b)
+{     /* better estimate first, then lower column number */
+      const struct rb_cand *x = a, *y = b;
+      if (x->score > y->score) return -1;
+      if (x->score < y->score) return +1;
+      return x->j - y->j;
+}
+
+int ios_rel_branch(glp_tree *T, int *_next)
+{     struct csa *csa;
+      struct rb_cand *cand;
+      struct rb_pool pool;
+      glp_bfcp bfcp;
+      int n = T->n, rel = T->parm->rb_rel, nthreads = T->parm->rb_threads;
+      int j, k, t, ncand, nn, jjj, sel, stall;
+      double beta, dn_avg, up_avg, d1, d2, s, smax;
+      if (T->pcost == NULL)
+         T->pcost = ios_pcost_init(T);
+      csa = T->pcost;
+      /* average per unit degradations, assumed for the candidates,
+         which have no pseudocost yet */
+      dn_avg = up_avg = 0.0;
+      for (nn = 0, j = 1; j <= n; j++)
+      {  if (csa->dn_cnt[j] > 0)
+            dn_avg += csa->dn_sum[j] / (double)csa->dn_cnt[j], nn++;
+      }
+      dn_avg = (nn > 0 ? dn_avg / (double)nn : 1.0);
+      for (nn = 0, j = 1; j <= n; j++)
+      {  if (csa->up_cnt[j] > 0)
+            up_avg += csa->up_sum[j] / (double)csa->up_cnt[j], nn++;
+      }
+      up_avg = (nn > 0 ? up_avg / (double)nn : 1.0);
+      /* choose among the reliable candidates and collect the others */
+      cand = xcalloc(1+n, sizeof(struct rb_cand));
+      ncand = 0, jjj = 0, sel = GLP_DN_BRNCH, smax = -1.0;
+      for (j = 1; j <= n; j++)
+      {  if (!glp_ios_can_branch(T, j)) continue;
+         beta = T->mip->col[j]->prim;
+         d1 = (csa->dn_cnt[j] > 0 ? csa->dn_sum[j] /
+            (double)csa->dn_cnt[j] : dn_avg) * (beta - floor(beta));
+         d2 = (csa->up_cnt[j] > 0 ? csa->up_sum[j] /
+            (double)csa->up_cnt[j] : up_avg) * (ceil(beta) - beta);
+         s = rb_score(d1, d2);
+         if (csa->dn_cnt[j] >= rel && csa->up_cnt[j] >= rel)
+         {  if (smax < s)
+            {  smax = s, jjj = j;
+               sel = (d1 <= d2 ? GLP_DN_BRNCH : GLP_UP_BRNCH);
+            }
+         }
+         else
+         {  ncand++;
+            cand[ncand].j = j, cand[ncand].score = s;
+         }
+      }
+      if (ncand == 0) goto done;
+      qsort(&cand[1], ncand, sizeof(struct rb_cand), rb_cmp);
+      /* evaluate the unreliable candidates */
+      if (nthreads == 0)
+      {
+#ifdef _SC_NPROCESSORS_ONLN
+         nthreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+         if (nthreads < 1) nthreads = 1;
+      }
+      if (nthreads > ncand) nthreads = ncand;
+      /* the copies only read the current LP; make sure that reading
+         its factorization parameters does not create them */
+      glp_get_bfcp(T->mip, &bfcp);
+      pool.P = T->mip;
+      pool.it_lim = T->parm->rb_it_lim;
+      pool.task = xcalloc(nthreads, sizeof(struct rb_task));
+      pool.failed = 0;
+      pthread_mutex_init(&pool.lock, NULL);
+      stall = 0;
+      for (k = 1; k <= ncand && stall < RB_LOOKAHEAD; k += pool.count)
+      {  /* a batch must not go past the candidate, at which the serial
+            search would stop; stall grows by at most one per candidate,
+            so that it can only reach RB_LOOKAHEAD on the last one */
+         pool.count = (ncand - k + 1 < nthreads ? ncand - k + 1 :
+            nthreads);
+         if (pool.count > RB_LOOKAHEAD - stall)
+            pool.count = RB_LOOKAHEAD - stall;
+         for (t = 0; t < pool.count; t++)
+         {  pool.task[t].j = cand[k+t].j;
+            pool.task[t].beta = T->mip->col[cand[k+t].j]->prim;
+         }
+         rb_run(&pool, nthreads);
+         /* take the results in candidate order, so that the choice
+            does not depend on the threads */
+         for (t = 0; t < pool.count; t++)
+         {  j = pool.task[t].j, beta = pool.task[t].beta;
+            d1 = pool.task[t].dn, d2 = pool.task[t].up;
+            if (d1 == DBL_MAX || d2 == DBL_MAX)
+            {  /* one branch has no primal feasible solution */
+               jjj = j;
+               sel = (d1 == DBL_MAX ? GLP_DN_BRNCH : GLP_UP_BRNCH);
+               smax = DBL_MAX;
+               break;
+            }
+            csa->dn_cnt[j]++;
+            csa->dn_sum[j] += d1 / (beta - floor(beta));
+            csa->up_cnt[j]++;
+            csa->up_sum[j] += d2 / (ceil(beta) - beta);
+            s = rb_score(d1, d2);
+            if (smax < s)
+            {  smax = s, jjj = j, stall = 0;
+               sel = (d1 <= d2 ? GLP_DN_BRNCH : GLP_UP_BRNCH);
+            }
+            else
+               stall++;
+         }
+         if (smax == DBL_MAX) break;
+      }
+      pthread_mutex_destroy(&pool.lock);
+      xfree(pool.task);
+done: xfree(cand);
+      if (smax <= rb_score(0.0, 0.0))
+      {  /* no degradation is indicated; choose a variable having most
+            fractional value */
+         jjj = branch_mostf(T, &sel);
+      }
+      *_next = sel;
+      return jjj;
+}
+
 /* eof */
@@ -840,7 +840,8 @@ static void terminate(struct csa *csa)
 *  1 - problem has no feasible (primal or dual) solution;
 *  2 - no convergence;
 *  3 - iteration limit exceeded;
-*  4 - numeric instability on solving Newtonian system.
+*  4 - numeric instability on solving Newtonian system;
+*  5 - search cancelled by the application.
 *
 *  In case of non-zero return code the routine returns the best point,
 *  which has been reached during optimization. */
@@ -913,6 +914,13 @@ static int ipm_main(struct csa *csa)
             status = 3;
             break;
          }
+         /* check if the search has been cancelled by the application */
+         if (csa->parm->abort != NULL && *csa->parm->abort)
+         {  if (csa->parm->msg_lev >= GLP_MSG_ALL)
+               xprintf("SEARCH CANCELLED BY APPLICATION\n");
+            status = 5;
+            break;
+         }
          /* start the next iteration */
          csa->iter++;
          /* factorize normal equation system */
@@ -1018,6 +1026,9 @@ static int ipm_main(struct csa *csa)
 *  GLP_EINSTAB
 *     Numeric instability on solving Newtonian system.
 *
+*  GLP_ECANCEL
+*     The search has been cancelled by the application.
+*
 *  In case of non-zero return code the routine returns the best point,
 *  which has been reached during optimization. */
 
@@ -1113,6 +1124,11 @@ int ipm_solve(glp_prob *P, const glp_iptcp *parm)
          P->ipt_stat = GLP_INFEAS;
          ret = GLP_EINSTAB;
       }
+      else if (ret == 5)
+      {  /* search cancelled by the application */
+         P->ipt_stat = GLP_INFEAS;
+         ret = GLP_ECANCEL;
+      }
       else
          xassert(ret != ret);
       /* store row solution components */
@@ -166,6 +166,8 @@
 		"simplex/spxnt.c",
 		"simplex/spxprim.c",
 		"simplex/spxprob.c",
+		"simplex/spxsimd.c",
+		"simplex/spxsift.c",
 
 		"simplex/spychuzc.c",
 		"simplex/spychuzr.c",
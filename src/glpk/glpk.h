@@ -123,12 +123,14 @@ typedef struct
 #define GLP_PRIMAL         1  /* use primal simplex */
 #define GLP_DUALP          2  /* use dual; if it fails, use primal */
 #define GLP_DUAL           3  /* use dual simplex */
+#define GLP_SIFTING        4  /* use primal simplex with sifting */
       int pricing;            /* pricing technique: */
 #define GLP_PT_STD      0x11  /* standard (Dantzig's rule) */
 #define GLP_PT_PSE      0x22  /* projected steepest edge */
       int r_test;             /* ratio test technique: */
 #define GLP_RT_STD      0x11  /* standard (textbook) */
 #define GLP_RT_HAR      0x22  /* Harris' two-pass ratio test */
+#define GLP_RT_FLIP     0x33  /* long-step (flip) ratio test */
       double tol_bnd;         /* spx.tol_bnd */
       double tol_dj;          /* spx.tol_dj */
       double tol_piv;         /* spx.tol_piv */
@@ -139,7 +141,10 @@ typedef struct
       int out_frq;            /* spx.out_frq */
       int out_dly;            /* spx.out_dly (milliseconds) */
       int presolve;           /* enable/disable using LP presolver */
-      double foo_bar[36];     /* (reserved) */
+      int simd;               /* enable/disable vectorised kernels */
+      int part_len;           /* partial pricing window (0 = off) */
+      volatile int *abort;    /* cancel the search when *abort != 0 */
+      double foo_bar[34];     /* (reserved) */
 } glp_smcp;
 
 typedef struct
@@ -150,7 +155,8 @@ typedef struct
 #define GLP_ORD_QMD        1  /* quotient minimum degree (QMD) */
 #define GLP_ORD_AMD        2  /* approx. minimum degree (AMD) */
 #define GLP_ORD_SYMAMD     3  /* approx. minimum degree (SYMAMD) */
-      double foo_bar[48];     /* (reserved) */
+      volatile int *abort;    /* (see glp_smcp) */
+      double foo_bar[47];     /* (reserved) */
 } glp_iptcp;
 
 typedef struct glp_tree glp_tree;
@@ -165,6 +171,7 @@ typedef struct
 #define GLP_BR_MFV         3  /* most fractional variable */
 #define GLP_BR_DTH         4  /* heuristic by Driebeck and Tomlin */
 #define GLP_BR_PCH         5  /* hybrid pseudocost heuristic */
+#define GLP_BR_RLB         6  /* reliability branching */
       int bt_tech;            /* backtracking technique: */
 #define GLP_BT_DFS         1  /* depth first search */
 #define GLP_BT_BFS         2  /* breadth first search */
@@ -202,12 +209,23 @@ typedef struct
       int ps_heur;            /* proximity search heuristic */
       int ps_tm_lim;          /* proxy time limit, milliseconds */
       int sr_heur;            /* simple rounding heuristic */
+      int threads;            /* threads of the node search; glp_intopt
+                                 itself is serial */
+      int par_det;            /* deterministic node search (GLP_ON/
+                                 GLP_OFF), threads > 1 */
+      int par_seed;           /* seed of the node search threads */
+      int rb_rel;             /* reliability threshold (GLP_BR_RLB) */
+      int rb_it_lim;          /* strong branching iteration limit */
+      int rb_threads;         /* strong branching threads; 0 means
+                                 one per processor */
+      int par_cuts;           /* run cut generators concurrently
+                                 (GLP_ON/GLP_OFF) */
 #if 1 /* 24/X-2015; not documented--should not be used */
       int use_sol;            /* use existing solution */
       const char *save_sol;   /* filename to save every new solution */
       int alien;              /* use alien solver */
 #endif
-      double foo_bar[24];     /* (reserved) */
+      double foo_bar[21];     /* (reserved) */
 } glp_iocp;
 
 typedef struct
@@ -267,6 +285,7 @@ typedef struct
 #define GLP_EINSTAB     0x11  /* numerical instability */
 #define GLP_EDATA       0x12  /* invalid data */
 #define GLP_ERANGE      0x13  /* result out of range */
+#define GLP_ECANCEL     0x14  /* search cancelled by application */
 
 /* condition indicator: */
 #define GLP_KKT_PE         1  /* primal equalities */
@@ -327,6 +346,17 @@ typedef struct {
     } presolve;
     ios_driver_ctx ios;
 } glp_mip_ctx;
+
+typedef struct {
+    int ret, done;
+    int it_cnt;     /* simplex iteration count, updated by glp_simplex_run */
+    const glp_smcp *parm;
+    glp_prob *P;    /* problem passed to glp_simplex_start */
+    glp_prob *lp;   /* problem being solved, P or the one built by the presolver */
+    void *npp;      /* presolver workspace */
+    void *wksp;     /* working LP, factorization and pricing data of the search */
+    int meth;       /* method of the search, GLP_PRIMAL or GLP_DUAL */
+} glp_smx_ctx;
     
 typedef struct glp_tran glp_tran;
 /* MathProg translator workspace */
@@ -393,6 +423,9 @@ void glp_del_cols(glp_prob *P, int ncs, const int num[]);
 void glp_copy_prob(glp_prob *dest, glp_prob *prob, int names);
 /* copy problem object content */
 
+void glp_copy_sol(glp_prob *dest, glp_prob *prob, int sol);
+/* copy solution from another problem object */
+
 void glp_erase_prob(glp_prob *P);
 /* erase problem object content */
 
@@ -498,6 +531,12 @@ void glp_cpx_basis(glp_prob *P);
 int glp_simplex(glp_prob *P, const glp_smcp *parm);
 /* solve LP problem with the simplex method */
 
+void glp_init_smx_ctx(glp_smx_ctx *ctx);
+void glp_simplex_start(glp_prob *P, glp_smx_ctx *ctx);
+void glp_simplex_run(glp_smx_ctx *ctx, int it_lim, int tm_lim);
+void glp_simplex_stop(glp_prob *P, glp_smx_ctx *ctx);
+/* solve LP problem with the simplex method in resumable steps */
+
 int glp_exact(glp_prob *P, const glp_smcp *parm);
 /* solve LP problem in exact arithmetic */
 
@@ -607,6 +646,9 @@ double glp_mip_row_val(glp_prob *P, int i);
 double glp_mip_col_val(glp_prob *P, int j);
 /* retrieve column value (MIP solution) */
 
+void glp_put_mip_sol(glp_prob *P, int stat, const double x[]);
+/* store MIP solution found elsewhere */
+
 void glp_check_kkt(glp_prob *P, int sol, int cond, double *ae_max,
       int *ae_ind, double *re_max, int *re_ind);
 /* check feasibility/optimality conditions */
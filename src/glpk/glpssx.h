@@ -319,6 +319,9 @@ struct SSX
          performed by the amount of time spent for the iteration, and
          reaching zero value signals the solver to stop the search;
          negative value means no time limit */
+      volatile int *abort;
+      /* pointer to a flag set by the application to cancel the search;
+         NULL means the search cannot be cancelled */
       double out_frq;
       /* output frequency, in seconds; this parameter specifies how
          frequently the solver sends information about the progress of
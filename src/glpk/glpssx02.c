@@ -52,7 +52,8 @@ static void show_progress(SSX *ssx, int phase)
 // 0 - feasible solution found;
 // 1 - problem has no feasible solution;
 // 2 - iterations limit exceeded;
-// 3 - time limit exceeded.
+// 3 - time limit exceeded;
+// 4 - search cancelled by the application.
 ----------------------------------------------------------------------*/
 
 int ssx_phase_I(SSX *ssx)
@@ -165,6 +166,11 @@ int ssx_phase_I(SSX *ssx)
          {  ret = 3;
             break;
          }
+         /* check if the search has been cancelled */
+         if (ssx->abort != NULL && *ssx->abort)
+         {  ret = 4;
+            break;
+         }
          /* choose non-basic variable xN[q] */
          ssx_chuzc(ssx);
          /* if xN[q] cannot be chosen, the sum of infeasibilities is
@@ -276,7 +282,8 @@ int ssx_phase_I(SSX *ssx)
 // 0 - optimal solution found;
 // 1 - problem has unbounded solution;
 // 2 - iterations limit exceeded;
-// 3 - time limit exceeded.
+// 3 - time limit exceeded;
+// 4 - search cancelled by the application.
 ----------------------------------------------------------------------*/
 
 int ssx_phase_II(SSX *ssx)
@@ -307,6 +314,11 @@ int ssx_phase_II(SSX *ssx)
          {  ret = 3;
             break;
          }
+         /* check if the search has been cancelled */
+         if (ssx->abort != NULL && *ssx->abort)
+         {  ret = 4;
+            break;
+         }
          /* choose non-basic variable xN[q] */
          ssx_chuzc(ssx);
          /* if xN[q] cannot be chosen, the current basic solution is
@@ -367,7 +379,9 @@ int ssx_phase_II(SSX *ssx)
 // 4 - iterations limit exceeded (phase II);
 // 5 - time limit exceeded (phase I);
 // 6 - time limit exceeded (phase II);
-// 7 - initial basis matrix is exactly singular.
+// 7 - initial basis matrix is exactly singular;
+// 8 - search cancelled by the application (phase I);
+// 9 - search cancelled by the application (phase II).
 ----------------------------------------------------------------------*/
 
 int ssx_driver(SSX *ssx)
@@ -430,6 +444,10 @@ int ssx_driver(SSX *ssx)
             xprintf("TIME LIMIT EXCEEDED; SEARCH TERMINATED\n");
             ret = 5;
             break;
+         case 4:
+            xprintf("SEARCH CANCELLED BY APPLICATION\n");
+            ret = 8;
+            break;
          default:
             xassert(ret != ret);
       }
@@ -461,6 +479,10 @@ skip: /* compute simplex multipliers */
             xprintf("TIME LIMIT EXCEEDED; SEARCH TERMINATED\n");
             ret = 6;
             break;
+         case 4:
+            xprintf("SEARCH CANCELLED BY APPLICATION\n");
+            ret = 9;
+            break;
          default:
             xassert(ret != ret);
       }
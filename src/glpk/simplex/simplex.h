@@ -34,6 +34,38 @@ int spx_primal(glp_prob *P, const glp_smcp *parm);
 int spy_dual(glp_prob *P, const glp_smcp *parm);
 /* driver to dual simplex method */
 
+#define spx_sifting _glp_spx_sifting
+int spx_sifting(glp_prob *P, const glp_smcp *parm);
+/* driver to sifting method */
+
+#define SPX_YIELD (-100)
+/* returned by spx_primal_run and spy_dual_run if the search has been
+ * suspended */
+
+#define spx_primal_start _glp_spx_primal_start
+void *spx_primal_start(glp_prob *P, const glp_smcp *parm);
+/* start primal simplex method, which can be suspended */
+
+#define spx_primal_run _glp_spx_primal_run
+int spx_primal_run(void *wksp, int it_lim, double tm_lim, int *it_cnt);
+/* continue primal simplex method for a limited time */
+
+#define spx_primal_stop _glp_spx_primal_stop
+int spx_primal_stop(void *wksp);
+/* store results of primal simplex method and free its workspace */
+
+#define spy_dual_start _glp_spy_dual_start
+void *spy_dual_start(glp_prob *P, const glp_smcp *parm);
+/* start dual simplex method, which can be suspended */
+
+#define spy_dual_run _glp_spy_dual_run
+int spy_dual_run(void *wksp, int it_lim, double tm_lim, int *it_cnt);
+/* continue dual simplex method for a limited time */
+
+#define spy_dual_stop _glp_spy_dual_stop
+int spy_dual_stop(void *wksp);
+/* store results of dual simplex method and free its workspace */
+
 #endif
 
 /* eof */
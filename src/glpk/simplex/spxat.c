@@ -28,7 +28,8 @@
 *  spx_alloc_at - allocate constraint matrix in sparse row-wise format
 *
 *  This routine allocates the memory for arrays needed to represent the
-*  constraint matrix in sparse row-wise format. */
+*  constraint matrix in sparse row-wise format, and selects the kernel
+*  variant used for the products with the matrix. */
 
 void spx_alloc_at(SPXLP *lp, SPXAT *at)
 {     int m = lp->m;
@@ -38,6 +39,8 @@ void spx_alloc_at(SPXLP *lp, SPXAT *at)
       at->ind = talloc(1+nnz, int);
       at->val = talloc(1+nnz, double);
       at->work = talloc(1+n, double);
+      at->list = talloc(1+n, int);
+      at->simd = spx_simd();
       return;
 }
 
@@ -119,6 +122,11 @@ void spx_at_prod(SPXLP *lp, SPXAT *at, double y[/*1+n*/], double s,
             t = s * x[i];
             ptr = AT_ptr[i];
             end = AT_ptr[i+1];
+            if (at->simd != SPX_SIMD_OFF && end - ptr >= SPX_SIMD_LEN)
+            {  spx_simd_axpy(at->simd, end - ptr, &AT_ind[ptr],
+                  &AT_val[ptr], t, y);
+               continue;
+            }
             for (; ptr < end; ptr++)
                y[AT_ind[ptr]] += AT_val[ptr] * t;
          }
@@ -227,18 +235,28 @@ void spx_eval_trow1(SPXLP *lp, SPXAT *at, const double rho[/*1+m*/],
          int *A_ind = lp->A_ind;
          double *A_val = lp->A_val;
          int *head = lp->head;
-         int k, ptr, end;
+         int *list = at->list;
+         int k, ptr, end, len;
          double tij;
+         len = 0;
          for (j = 1; j <= n-m; j++)
          {  k = head[m+j]; /* x[k] = xN[j] */
-            /* compute t[i,j] = - N'[j] * pi */
-            tij = 0.0;
             ptr = A_ptr[k];
             end = A_ptr[k+1];
+            if (at->simd != SPX_SIMD_OFF && end - ptr >= SPX_SIMD_LEN)
+            {  /* left to the vectorised kernel */
+               list[++len] = j;
+               continue;
+            }
+            /* compute t[i,j] = - N'[j] * pi */
+            tij = 0.0;
             for (; ptr < end; ptr++)
                tij -= A_val[ptr] * rho[A_ind[ptr]];
             trow[j] = tij;
          }
+         if (len > 0)
+            spx_simd_cols(at->simd, m, len, list, A_ptr, A_ind, A_val,
+               head, rho, trow);
       }
       else
       {  /* as linear combination */
@@ -259,6 +277,7 @@ void spx_free_at(SPXLP *lp, SPXAT *at)
       tfree(at->ind);
       tfree(at->val);
       tfree(at->work);
+      tfree(at->list);
       return;
 }
 
@@ -25,6 +25,7 @@
 #define SPXAT_H
 
 #include "spxlp.h"
+#include "spxsimd.h"
 
 typedef struct SPXAT SPXAT;
 
@@ -46,6 +47,12 @@ struct SPXAT
       /* non-zero element values */
       double *work; /* double work[1+n]; */
       /* working array */
+      int *list; /* int list[1+n]; */
+      /* working array */
+      int simd;
+      /* kernel variant used for the products, SPX_SIMD_OFF for the
+       * scalar code (see spxsimd.h); set by spx_alloc_at to the best
+       * one for the processor */
 };
 
 #define spx_alloc_at _glp_spx_alloc_at
@@ -24,6 +24,47 @@
 #include "glpenv.h"
 #include "spxchuzc.h"
 
+/***********************************************************************
+*  eligible - check if non-basic variable is eligible
+*
+*  This routine returns non-zero if non-basic variable xN[j] is eligible
+*  as defined for the routine spx_chuzc_sel. */
+
+static int eligible(SPXLP *lp, const double d[/*1+n-m*/], double tol,
+      double tol1, int j)
+{     int m = lp->m;
+      int k = lp->head[m+j]; /* x[k] = xN[j] */
+      double ck, eps;
+      if (lp->l[k] == lp->u[k])
+      {  /* xN[j] is fixed variable; skip it */
+         return 0;
+      }
+      /* determine absolute tolerance eps[j] */
+      ck = lp->c[k];
+      eps = tol + tol1 * (ck >= 0.0 ? +ck : -ck);
+      /* check if xN[j] is eligible */
+      if (d[j] <= -eps)
+      {  /* xN[j] should be able to increase */
+         if (lp->flag[j])
+         {  /* but its upper bound is active */
+            return 0;
+         }
+      }
+      else if (d[j] >= +eps)
+      {  /* xN[j] should be able to decrease */
+         if (!lp->flag[j] && lp->l[k] != -DBL_MAX)
+         {  /* but its lower bound is active */
+            return 0;
+         }
+      }
+      else /* -eps < d[j] < +eps */
+      {  /* xN[j] does not affect the objective function within the
+          * specified tolerance */
+         return 0;
+      }
+      return 1;
+}
+
 /***********************************************************************
 *  spx_chuzc_sel - select eligible non-basic variables
 *
@@ -56,44 +97,12 @@ int spx_chuzc_sel(SPXLP *lp, const double d[/*1+n-m*/], double tol,
       double tol1, int list[/*1+n-m*/])
 {     int m = lp->m;
       int n = lp->n;
-      double *c = lp->c;
-      double *l = lp->l;
-      double *u = lp->u;
-      int *head = lp->head;
-      char *flag = lp->flag;
-      int j, k, num;
-      double ck, eps;
+      int j, num;
       num = 0;
       /* walk thru list of non-basic variables */
       for (j = 1; j <= n-m; j++)
-      {  k = head[m+j]; /* x[k] = xN[j] */
-         if (l[k] == u[k])
-         {  /* xN[j] is fixed variable; skip it */
+      {  if (!eligible(lp, d, tol, tol1, j))
             continue;
-         }
-         /* determine absolute tolerance eps[j] */
-         ck = c[k];
-         eps = tol + tol1 * (ck >= 0.0 ? +ck : -ck);
-         /* check if xN[j] is eligible */
-         if (d[j] <= -eps)
-         {  /* xN[j] should be able to increase */
-            if (flag[j])
-            {  /* but its upper bound is active */
-               continue;
-            }
-         }
-         else if (d[j] >= +eps)
-         {  /* xN[j] should be able to decrease */
-            if (!flag[j] && l[k] != -DBL_MAX)
-            {  /* but its lower bound is active */
-               continue;
-            }
-         }
-         else /* -eps < d[j] < +eps */
-         {  /* xN[j] does not affect the objective function within the
-             * specified tolerance */
-            continue;
-         }
          /* xN[j] is eligible non-basic variable */
          num++;
          if (list != NULL)
@@ -156,6 +165,9 @@ void spx_alloc_se(SPXLP *lp, SPXSE *se)
       se->refsp = talloc(1+n, char);
       se->gamma = talloc(1+n-m, double);
       se->work = talloc(1+m, double);
+      se->work1 = talloc(1+n-m, double);
+      se->list = talloc(1+n-m, int);
+      se->simd = spx_simd();
       return;
 }
 
@@ -305,17 +317,25 @@ int spx_chuzc_pse(SPXLP *lp, SPXSE *se, const double d[/*1+n-m*/],
 *  where gamma'[q] is the weight for xN[q] on entry to the routine,
 *  and returns e on exit. (If e happens to be large enough, the calling
 *  program may reset the reference space, since other weights also may
-*  be inaccurate.) */
+*  be inaccurate.)
+*
+*  The inner products with long columns of N are computed by the
+*  vectorised kernel se->simd; the results are the same. */
 
 double spx_update_gamma(SPXLP *lp, SPXSE *se, int p, int q,
       const double trow[/*1+n-m*/], const double tcol[/*1+m*/])
 {     int m = lp->m;
       int n = lp->n;
       int *head = lp->head;
+      int *A_ptr = lp->A_ptr;
+      int *A_ind = lp->A_ind;
+      double *A_val = lp->A_val;
       char *refsp = se->refsp;
       double *gamma = se->gamma;
       double *u = se->work;
-      int i, j, k, ptr, end;
+      double *w = se->work1;
+      int *list = se->list;
+      int i, j, k, t, ptr, end, len;
       double gamma_q, delta_q, e, r, s, t1, t2;
       xassert(se->valid);
       xassert(1 <= p && p <= m);
@@ -339,6 +359,7 @@ double spx_update_gamma(SPXLP *lp, SPXSE *se, int p, int q,
       /* compute new gamma[q] */
       gamma[q] = gamma_q / (tcol[p] * tcol[p]);
       /* compute new gamma[j] for all j != q */
+      len = 0;
       for (j = 1; j <= n-m; j++)
       {  if (j == q)
             continue;
@@ -346,21 +367,41 @@ double spx_update_gamma(SPXLP *lp, SPXSE *se, int p, int q,
          {  /* T[p,j] is close to zero; gamma[j] is not changed */
             continue;
          }
+         k = head[m+j]; /* x[k] = xN[j] */
+         ptr = A_ptr[k];
+         end = A_ptr[k+1];
+         if (se->simd != SPX_SIMD_OFF && end - ptr >= SPX_SIMD_LEN)
+         {  /* left to the vectorised kernel */
+            list[++len] = j;
+            continue;
+         }
          /* compute r[j] = T[p,j] / T[p,q] */
          r = trow[j] / tcol[p];
          /* compute inner product s[j] = N'[j] * u, where N[j] = A[k]
           * is constraint matrix column corresponding to xN[j] */
          s = 0.0;
-         k = head[m+j]; /* x[k] = xN[j] */
-         ptr = lp->A_ptr[k];
-         end = lp->A_ptr[k+1];
          for (; ptr < end; ptr++)
-            s += lp->A_val[ptr] * u[lp->A_ind[ptr]];
+            s += A_val[ptr] * u[A_ind[ptr]];
          /* compute new gamma[j] */
          t1 = gamma[j] + r * (r * gamma_q + s + s);
          t2 = (refsp[k] ? 1.0 : 0.0) + delta_q * r * r;
          gamma[j] = (t1 >= t2 ? t1 : t2);
       }
+      if (len > 0)
+      {  /* w[j] = - N'[j] * u, which is exactly -s[j], except that the
+          * kernel may give -0 for s[j] = +0 */
+         spx_simd_cols(se->simd, m, len, list, A_ptr, A_ind, A_val,
+            head, u, w);
+         for (t = 1; t <= len; t++)
+         {  j = list[t];
+            k = head[m+j]; /* x[k] = xN[j] */
+            r = trow[j] / tcol[p];
+            s = 0.0 - w[j];
+            t1 = gamma[j] + r * (r * gamma_q + s + s);
+            t2 = (refsp[k] ? 1.0 : 0.0) + delta_q * r * r;
+            gamma[j] = (t1 >= t2 ? t1 : t2);
+         }
+      }
       return e;
 }
 
@@ -375,6 +416,120 @@ void spx_free_se(SPXLP *lp, SPXSE *se)
       tfree(se->refsp);
       tfree(se->gamma);
       tfree(se->work);
+      tfree(se->work1);
+      tfree(se->list);
+      return;
+}
+
+/***********************************************************************
+*  spx_alloc_pp - allocate partial pricing data block
+*
+*  This routine allocates the memory for arrays used in the partial
+*  pricing data block, which prices len non-basic variables per call
+*  to the routine spx_chuzc_part. */
+
+void spx_alloc_pp(SPXLP *lp, SPXPP *pp, int len)
+{     int m = lp->m;
+      int n = lp->n;
+      xassert(len > 0);
+      pp->len = len;
+      pp->pos = 1;
+      pp->num = 0;
+      pp->mark = talloc(1+n-m, char);
+      memset(&pp->mark[1], 0, (n-m) * sizeof(char));
+      return;
+}
+
+/***********************************************************************
+*  spx_chuzc_part - select eligible non-basic variables partially
+*
+*  This routine selects eligible non-basic variables xN[j] as the
+*  routine spx_chuzc_sel does, but does not price all of them.
+*
+*  First the routine checks the candidates kept from its previous call,
+*  and then it prices the non-basic variables in windows of pp->len
+*  variables, starting from the one following the last window priced
+*  and wrapping around xN[n-m]: one window always, and more until at
+*  least one eligible variable is found or all non-basic variables have
+*  been priced. Thus, it returns
+*  zero only if the routine spx_chuzc_sel would, and the caller may
+*  conclude that the current basis is optimal in that case.
+*
+*  On exit the routine stores indices j of eligible non-basic variables
+*  found to the array locations list[1], ..., list[num] and returns the
+*  number of such variables. It also keeps up to SPX_PP_CAND of them,
+*  which have the largest scores, to check them on the next call; the
+*  score is d[j]^2 / gamma[j] if the projected steepest edge weights se
+*  are specified, and |d[j]| otherwise (se = NULL).
+*
+*  Note that the weights must be valid for all non-basic variables, so
+*  the caller should keep updating them as for full pricing. */
+
+int spx_chuzc_part(SPXLP *lp, SPXPP *pp, SPXSE *se,
+      const double d[/*1+n-m*/], double tol, double tol1,
+      int list[/*1+n-m*/])
+{     int m = lp->m;
+      int n = lp->n;
+      int *cand = pp->cand;
+      char *mark = pp->mark;
+      int j, k, t, num, cnt, start, end;
+      double temp, score[1+SPX_PP_CAND];
+      xassert(se == NULL || se->valid);
+      num = 0;
+      /* check the candidates kept from the previous call */
+      for (t = 1; t <= pp->num; t++)
+      {  j = cand[t];
+         if (eligible(lp, d, tol, tol1, j))
+            mark[j] = 1, list[++num] = j;
+      }
+      /* price at least one window of non-basic variables, and more
+       * until some eligible ones are found */
+      for (cnt = 0; cnt < n-m; cnt += j - start)
+      {  if (cnt > 0 && num > 0)
+            break;
+         start = pp->pos, end = start + pp->len;
+         /* the window is cut short at xN[n-m], so only the variables
+          * actually priced are counted */
+         for (j = start; j < end && j <= n-m; j++)
+         {  if (!mark[j] && eligible(lp, d, tol, tol1, j))
+               mark[j] = 1, list[++num] = j;
+         }
+         /* the next window starts where this one has stopped */
+         pp->pos = (j > n-m ? 1 : j);
+      }
+      /* keep the best candidates; their scores are in decreasing order
+       * in cand[1], ..., cand[pp->num] */
+      pp->num = 0;
+      for (k = 1; k <= num; k++)
+      {  j = list[k];
+         mark[j] = 0;
+         if (se == NULL)
+            temp = (d[j] >= 0.0 ? +d[j] : -d[j]);
+         else if (se->gamma[j] < DBL_EPSILON)
+            temp = 0.0;
+         else
+            temp = (d[j] * d[j]) / se->gamma[j];
+         if (pp->num == SPX_PP_CAND)
+         {  if (temp <= score[SPX_PP_CAND])
+               continue;
+            pp->num--;
+         }
+         for (t = ++(pp->num); t > 1 && score[t-1] < temp; t--)
+            cand[t] = cand[t-1], score[t] = score[t-1];
+         cand[t] = j, score[t] = temp;
+      }
+      return num;
+}
+
+/***********************************************************************
+*  spx_free_pp - deallocate partial pricing data block
+*
+*  This routine deallocates the memory used for arrays in the partial
+*  pricing data block. */
+
+void spx_free_pp(SPXLP *lp, SPXPP *pp)
+{     xassert(lp == lp);
+      tfree(pp->mark);
       return;
 }
 
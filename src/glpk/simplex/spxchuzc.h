@@ -25,6 +25,7 @@
 #define SPXCHUZC_H
 
 #include "spxlp.h"
+#include "spxsimd.h"
 
 #define spx_chuzc_sel _glp_spx_chuzc_sel
 int spx_chuzc_sel(SPXLP *lp, const double d[/*1+n-m*/], double tol,
@@ -52,6 +53,15 @@ struct SPXSE
        * of non-basic variable xN[j] in the current basis */
       double *work; /* double work[1+m]; */
       /* working array */
+      double *work1; /* double work1[1+n-m]; */
+      /* working array */
+      int *list; /* int list[1+n-m]; */
+      /* working array */
+      int simd;
+      /* variant of the kernel computing inner products with columns of
+       * N to update the weights, SPX_SIMD_OFF for the scalar code (see
+       * spxsimd.h); set by spx_alloc_se to the best variant for the
+       * processor, the calling program may change it */
 };
 
 #define spx_alloc_se _glp_spx_alloc_se
@@ -80,6 +90,42 @@ double spx_update_gamma(SPXLP *lp, SPXSE *se, int p, int q,
 void spx_free_se(SPXLP *lp, SPXSE *se);
 /* deallocate pricing data block */
 
+#define SPX_PP_CAND 16
+/* maximal number of candidates kept between iterations in partial
+ * pricing */
+
+typedef struct SPXPP SPXPP;
+
+struct SPXPP
+{     /* partial pricing data block */
+      int len;
+      /* number of non-basic variables priced per window */
+      int pos;
+      /* xN[pos] is the first non-basic variable of the next window */
+      int num;
+      /* number of candidates kept from the previous call */
+      int cand[1+SPX_PP_CAND];
+      /* cand[0] is not used;
+       * cand[1], ..., cand[num] are indices j of the candidates xN[j],
+       * the most attractive first */
+      char *mark; /* char mark[1+n-m]; */
+      /* working array; all its elements are zero between calls */
+};
+
+#define spx_alloc_pp _glp_spx_alloc_pp
+void spx_alloc_pp(SPXLP *lp, SPXPP *pp, int len);
+/* allocate partial pricing data block */
+
+#define spx_chuzc_part _glp_spx_chuzc_part
+int spx_chuzc_part(SPXLP *lp, SPXPP *pp, SPXSE *se,
+      const double d[/*1+n-m*/], double tol, double tol1,
+      int list[/*1+n-m*/]);
+/* select eligible non-basic variables partially */
+
+#define spx_free_pp _glp_spx_free_pp
+void spx_free_pp(SPXLP *lp, SPXPP *pp);
+/* deallocate partial pricing data block */
+
 #endif
 
 /* eof */
@@ -28,7 +28,8 @@
 *  spx_alloc_nt - allocate matrix N in sparse row-wise format
 *
 *  This routine allocates the memory for arrays needed to represent the
-*  matrix N composed of non-basic columns of the constraint matrix A. */
+*  matrix N composed of non-basic columns of the constraint matrix A,
+*  and selects the kernel variant used for the products with N. */
 
 void spx_alloc_nt(SPXLP *lp, SPXNT *nt)
 {     int m = lp->m;
@@ -37,6 +38,7 @@ void spx_alloc_nt(SPXLP *lp, SPXNT *nt)
       nt->len = talloc(1+m, int);
       nt->ind = talloc(1+nnz, int);
       nt->val = talloc(1+nnz, double);
+      nt->simd = spx_simd();
       return;
 }
 
@@ -235,6 +237,11 @@ void spx_nt_prod(SPXLP *lp, SPXNT *nt, double y[/*1+n-m*/], int ign,
             t = s * x[i];
             ptr = NT_ptr[i];
             end = ptr + NT_len[i];
+            if (nt->simd != SPX_SIMD_OFF && end - ptr >= SPX_SIMD_LEN)
+            {  spx_simd_axpy(nt->simd, end - ptr, &NT_ind[ptr],
+                  &NT_val[ptr], t, y);
+               continue;
+            }
             for (; ptr < end; ptr++)
                y[NT_ind[ptr]] += NT_val[ptr] * t;
          }
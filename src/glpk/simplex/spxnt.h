@@ -25,6 +25,7 @@
 #define SPXNT_H
 
 #include "spxlp.h"
+#include "spxsimd.h"
 
 typedef struct SPXNT SPXNT;
 
@@ -49,6 +50,10 @@ struct SPXNT
       /* column indices */
       double *val; /* double val[1+nnz]; */
       /* non-zero element values */
+      int simd;
+      /* kernel variant used for the products, SPX_SIMD_OFF for the
+       * scalar code (see spxsimd.h); set by spx_alloc_nt to the best
+       * one for the processor */
 };
 
 #define spx_alloc_nt _glp_spx_alloc_nt
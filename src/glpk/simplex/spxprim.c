@@ -83,6 +83,9 @@ struct csa
       SPXSE *se;
       /* projected steepest edge and Devex pricing data block (NULL if
        * not used) */
+      SPXPP *pp;
+      /* partial pricing data block (NULL if all non-basic variables
+       * are priced on every iteration) */
       int num;
       /* number of eligible non-basic variables */
       int *list; /* int list[1+n-m]; */
@@ -124,6 +127,8 @@ struct csa
       /* iteration limit */
       int tm_lim;
       /* time limit, milliseconds */
+      volatile int *abort;
+      /* the search is cancelled once *abort is non-zero */
       int out_frq;
       /* display output frequency, iterations */
       int out_dly;
@@ -142,6 +147,17 @@ struct csa
       /* simplex iteration count at most recent display output */
       int inv_cnt;
       /* basis factorization count since most recent display output */
+      int refct;
+      /* number of steepest edge weight updates left before the
+       * reference space is reset */
+      int it_run;
+      /* simplex iteration count at the beginning of the current run */
+      int it_yld;
+      /* the search is suspended once it_cnt reaches it_yld (0 means no
+       * iteration budget) */
+      double tm_yld;
+      /* the search is suspended once the time value reaches tm_yld
+       * (0 means no time budget) */
 };
 
 /***********************************************************************
@@ -667,6 +683,9 @@ skip: return;
 *  GLP_ETMLIM
 *     Time limit has been exhausted.
 *
+*  GLP_ECANCEL
+*     The search has been cancelled by the application.
+*
 *  GLP_EFAIL
 *     The solver failed to solve LP instance. */
 
@@ -692,7 +711,7 @@ static int primal_simplex(struct csa *csa)
       double tol_bnd1 = csa->tol_bnd1;
       double tol_dj = csa->tol_dj;
       double tol_dj1 = csa->tol_dj1;
-      int j, refct, ret;
+      int j, ret;
 loop: /* main loop starts here */
       /* compute factorization of the basis matrix */
       if (!lp->valid)
@@ -778,7 +797,7 @@ loop: /* main loop starts here */
       }
       /* reset the reference space, if necessary */
       if (se != NULL && !se->valid)
-         spx_reset_refsp(lp, se), refct = 1000;
+         spx_reset_refsp(lp, se), csa->refct = 1000;
       /* at this point the basis factorization and all basic solution
        * components are valid */
       xassert(lp->valid && csa->beta_st && csa->d_st);
@@ -819,15 +838,46 @@ loop: /* main loop starts here */
          ret = GLP_ETMLIM;
          goto fini;
       }
+      /* check if the search has been cancelled by the application */
+      if (csa->abort != NULL && *csa->abort)
+      {  if (csa->beta_st != 1)
+            csa->beta_st = 0;
+         if (csa->d_st != 1)
+            csa->d_st = 0;
+         if (!(csa->beta_st && csa->d_st))
+            goto loop;
+         display(csa, 1);
+         if (msg_lev >= GLP_MSG_ALL)
+            xprintf("SEARCH CANCELLED BY APPLICATION\n");
+         csa->p_stat = (csa->phase == 2 ? GLP_FEAS : GLP_INFEAS);
+         csa->d_stat = GLP_UNDEF; /* will be set below */
+         ret = GLP_ECANCEL;
+         goto fini;
+      }
+      /* check if the search has to be suspended; all working components
+       * are valid at this point, so it can be continued later by
+       * calling this routine again */
+      if (csa->it_cnt != csa->it_run &&
+         ((csa->it_yld != 0 && csa->it_cnt >= csa->it_yld) ||
+          (csa->tm_yld != 0.0 && xtime() >= csa->tm_yld)))
+         return SPX_YIELD;
       /* display the search progress */
       display(csa, 0);
       /* select eligible non-basic variables */
       switch (csa->phase)
       {  case 1:
-            csa->num = spx_chuzc_sel(lp, d, 1e-8, 0.0, list);
+            if (csa->pp == NULL)
+               csa->num = spx_chuzc_sel(lp, d, 1e-8, 0.0, list);
+            else
+               csa->num = spx_chuzc_part(lp, csa->pp, csa->se, d, 1e-8,
+                  0.0, list);
             break;
          case 2:
-            csa->num = spx_chuzc_sel(lp, d, tol_dj, tol_dj1, list);
+            if (csa->pp == NULL)
+               csa->num = spx_chuzc_sel(lp, d, tol_dj, tol_dj1, list);
+            else
+               csa->num = spx_chuzc_part(lp, csa->pp, csa->se, d,
+                  tol_dj, tol_dj1, list);
             break;
          default:
             xassert(csa != csa);
@@ -939,11 +989,11 @@ loop: /* main loop starts here */
       }
       /* update steepest edge weights for adjacent basis, if used */
       if (se != NULL)
-      {  if (refct > 0)
+      {  if (csa->refct > 0)
          {  if (spx_update_gamma(lp, se, csa->p, csa->q, trow, tcol)
                <= 1e-3)
             {  /* successful updating */
-               refct--;
+               csa->refct--;
             }
             else
             {  /* new weights are inaccurate; reset reference space */
@@ -981,9 +1031,10 @@ fini: /* restore original objective function */
       return ret;
 }
 
-int spx_primal(glp_prob *P, const glp_smcp *parm)
-{     /* driver to primal simplex method */
-      struct csa csa_, *csa = &csa_;
+struct wksp
+{     /* working objects of the primal simplex method, which are kept
+       * while the search is suspended */
+      struct csa csa;
       SPXLP lp;
 #if USE_AT
       SPXAT at;
@@ -991,13 +1042,32 @@ int spx_primal(glp_prob *P, const glp_smcp *parm)
       SPXNT nt;
 #endif
       SPXSE se;
-      int ret, *map, *daeh;
+      SPXPP pp;
+      glp_prob *P;
+      /* original problem object */
+      int *map;
+      /* map of original variables to working LP variables */
+      int ret;
+      /* code returned by the most recent run, SPX_YIELD if the search
+       * has not been finished yet */
+};
+
+void *spx_primal_start(glp_prob *P, const glp_smcp *parm)
+{     /* start primal simplex method; the search itself is performed
+       * by spx_primal_run */
+      struct wksp *wksp;
+      struct csa *csa;
+      int *map;
+      wksp = talloc(1, struct wksp);
+      memset(wksp, 0, sizeof(struct wksp));
+      wksp->P = P;
+      wksp->ret = SPX_YIELD;
       /* build working LP and its initial basis */
-      memset(csa, 0, sizeof(struct csa));
-      csa->lp = &lp;
+      csa = &wksp->csa;
+      csa->lp = &wksp->lp;
       spx_init_lp(csa->lp, P, EXCL);
       spx_alloc_lp(csa->lp);
-      map = talloc(1+P->m+P->n, int);
+      wksp->map = map = talloc(1+P->m+P->n, int);
       spx_build_lp(csa->lp, P, EXCL, SHIFT, map);
       spx_build_basis(csa->lp, P, map);
       switch (P->dir)
@@ -1014,15 +1084,19 @@ int spx_primal(glp_prob *P, const glp_smcp *parm)
       memcpy(csa->c, csa->lp->c, (1+csa->lp->n) * sizeof(double));
 #if USE_AT
       /* build matrix A in row-wise format */
-      csa->at = &at;
+      csa->at = &wksp->at;
       csa->nt = NULL;
       spx_alloc_at(csa->lp, csa->at);
+      if (parm->simd == GLP_OFF)
+         csa->at->simd = SPX_SIMD_OFF;
       spx_build_at(csa->lp, csa->at);
 #else
       /* build matrix N in row-wise format for initial basis */
       csa->at = NULL;
-      csa->nt = &nt;
+      csa->nt = &wksp->nt;
       spx_alloc_nt(csa->lp, csa->nt);
+      if (parm->simd == GLP_OFF)
+         csa->nt->simd = SPX_SIMD_OFF;
       spx_init_nt(csa->lp, csa->nt);
       spx_build_nt(csa->lp, csa->nt);
 #endif
@@ -1037,12 +1111,22 @@ int spx_primal(glp_prob *P, const glp_smcp *parm)
             csa->se = NULL;
             break;
          case GLP_PT_PSE:
-            csa->se = &se;
+            csa->se = &wksp->se;
             spx_alloc_se(csa->lp, csa->se);
+            if (parm->simd == GLP_OFF)
+               csa->se->simd = SPX_SIMD_OFF;
             break;
          default:
             xassert(parm != parm);
       }
+      /* partial pricing is of no use if the window covers all non-basic
+       * variables */
+      if (0 < parm->part_len && parm->part_len < csa->lp->n-csa->lp->m)
+      {  csa->pp = &wksp->pp;
+         spx_alloc_pp(csa->lp, csa->pp, parm->part_len);
+      }
+      else
+         csa->pp = NULL;
       csa->list = talloc(1+csa->lp->n-csa->lp->m, int);
       csa->tcol = talloc(1+csa->lp->m, double);
       csa->trow = talloc(1+csa->lp->n-csa->lp->m, double);
@@ -1054,6 +1138,9 @@ int spx_primal(glp_prob *P, const glp_smcp *parm)
             csa->harris = 0;
             break;
          case GLP_RT_HAR:
+         case GLP_RT_FLIP:
+            /* the long-step ratio test is only used in the dual
+             * simplex */
             csa->harris = 1;
             break;
          default:
@@ -1066,6 +1153,7 @@ int spx_primal(glp_prob *P, const glp_smcp *parm)
       csa->tol_piv = parm->tol_piv;
       csa->it_lim = parm->it_lim;
       csa->tm_lim = parm->tm_lim;
+      csa->abort = parm->abort;
       csa->out_frq = parm->out_frq;
       csa->out_dly = parm->out_dly;
       /* initialize working parameters */
@@ -1073,11 +1161,47 @@ int spx_primal(glp_prob *P, const glp_smcp *parm)
       csa->it_beg = csa->it_cnt = P->it_cnt;
       csa->it_dpy = -1;
       csa->inv_cnt = 0;
-      /* try to solve working LP */
-      ret = primal_simplex(csa);
+      return wksp;
+}
+
+int spx_primal_run(void *_wksp, int it_lim, double tm_lim, int *it_cnt)
+{     /* continue primal simplex method for at most it_lim iterations
+       * and tm_lim milliseconds (0 means no limit), at least one
+       * iteration is performed; the simplex iteration count is stored
+       * to it_cnt; returns SPX_YIELD if the search has been suspended,
+       * or the code to be returned by spx_primal */
+      struct wksp *wksp = _wksp;
+      struct csa *csa = &wksp->csa;
+      xassert(wksp->ret == SPX_YIELD);
+      csa->it_run = csa->it_cnt;
+      csa->it_yld = (it_lim == 0 ? 0 : csa->it_cnt + it_lim);
+      csa->tm_yld = (tm_lim == 0.0 ? 0.0 : xtime() + tm_lim);
+      wksp->ret = primal_simplex(csa);
+      *it_cnt = csa->it_cnt;
+      return wksp->ret;
+}
+
+int spx_primal_stop(void *_wksp)
+{     /* store results of primal simplex method to the problem object
+       * and free the workspace; if the search has not been finished,
+       * the problem object keeps its initial basis, the basic solution
+       * is undefined and GLP_ECANCEL is returned */
+      struct wksp *wksp = _wksp;
+      struct csa *csa = &wksp->csa;
+      glp_prob *P = wksp->P;
+      int ret = wksp->ret, *map = wksp->map, *daeh;
       /* return basis factorization back to problem object */
       P->valid = csa->lp->valid;
       P->bfd = csa->lp->bfd;
+      if (ret == SPX_YIELD)
+      {  /* the factorization does not correspond to the basis kept in
+          * the problem object */
+         P->valid = 0;
+         P->pbs_stat = P->dbs_stat = GLP_UNDEF;
+         P->it_cnt = csa->it_cnt;
+         ret = GLP_ECANCEL;
+         goto skip;
+      }
       /* set solution status */
       P->pbs_stat = csa->p_stat;
       P->dbs_stat = csa->d_stat;
@@ -1128,12 +1252,24 @@ skip: /* deallocate working objects and arrays */
       tfree(csa->d);
       if (csa->se != NULL)
          spx_free_se(csa->lp, csa->se);
+      if (csa->pp != NULL)
+         spx_free_pp(csa->lp, csa->pp);
       tfree(csa->list);
       tfree(csa->tcol);
       tfree(csa->trow);
       tfree(csa->work);
+      tfree(wksp);
       /* return to calling program */
       return ret;
 }
 
+int spx_primal(glp_prob *P, const glp_smcp *parm)
+{     /* driver to primal simplex method */
+      void *wksp;
+      int it_cnt;
+      wksp = spx_primal_start(P, parm);
+      spx_primal_run(wksp, 0, 0.0, &it_cnt);
+      return spx_primal_stop(wksp);
+}
+
 /* eof */
@@ -0,0 +1,443 @@
+/* spxsift.c */
+
+/***********************************************************************
+*  This code is part of GLPK (GNU Linear Programming Kit).
+*
+*  GLPK is free software: you can redistribute it and/or modify it
+*  under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  GLPK is distributed in the hope that it will be useful, but WITHOUT
+*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+*  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+*  License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with GLPK. If not, see <http://www.gnu.org/licenses/>.
+***********************************************************************/
+
+#include "glpenv.h"
+#include "simplex.h"
+
+#define SIFT_MIN 100
+/* minimal number of columns added to the working LP at a time */
+
+struct csa
+{     /* common storage area */
+      glp_prob *P;
+      /* original LP */
+      glp_prob *W;
+      /* working LP, which has the same rows as the original LP and
+       * some of its columns */
+      int *map; /* int map[1+n]; */
+      /* map[j] = jj > 0 means that column j of the original LP is
+       * column jj of the working LP; map[j] = 0 means that column j
+       * is excluded from the working LP */
+      int *col; /* int col[1+n]; */
+      /* col[jj] = j is the inverse of map */
+      char *rest; /* char rest[1+n]; */
+      /* rest[j] is the status (GLP_NL, GLP_NU, GLP_NS) column j keeps
+       * while it is excluded, or GLP_NF for free columns, which are
+       * never excluded */
+      double *shift; /* double shift[1+m]; */
+      /* shift[i] = sum a[i,j] * x[j] over excluded columns j, which
+       * is subtracted from the bounds of row i in the working LP */
+      double *y; /* double y[1+m]; */
+      /* simplex multipliers used to price excluded columns */
+      struct cand *cand; /* struct cand cand[1+n]; */
+      /* working array */
+      int batch;
+      /* maximal number of columns added to the working LP at a time */
+};
+
+struct cand
+{     /* excluded column which prices out */
+      int j;
+      /* column number */
+      double score;
+      /* magnitude of its reduced cost */
+};
+
+static int fcmp(const void *ptr1, const void *ptr2)
+{     /* this routine is passed to the qsort() function */
+      struct cand *c1 = (void *)ptr1, *c2 = (void *)ptr2;
+      if (c1->score > c2->score) return -1;
+      if (c1->score < c2->score) return +1;
+      return 0;
+}
+
+/***********************************************************************
+*  rest_value - value of excluded column */
+
+static double rest_value(struct csa *csa, int j)
+{     GLPCOL *col = csa->P->col[j];
+      switch (csa->rest[j])
+      {  case GLP_NL:
+         case GLP_NS:
+            return col->lb;
+         case GLP_NU:
+            return col->ub;
+         default:
+            xassert(csa != csa);
+      }
+      /* no return */
+      return 0.0;
+}
+
+/***********************************************************************
+*  add_col - add column of original LP to working LP
+*
+*  This routine adds column j of the original LP to the working LP as
+*  non-basic variable on the bound it has been kept at, or as basic
+*  variable, if bs is set, and removes its contribution from the row
+*  bounds and the objective constant term of the working LP. */
+
+static void add_col(struct csa *csa, int j, int bs, int ind[],
+      double val[])
+{     glp_prob *W = csa->W;
+      GLPCOL *col = csa->P->col[j];
+      GLPAIJ *aij;
+      int jj, len;
+      double xj;
+      xassert(csa->map[j] == 0);
+      jj = glp_add_cols(W, 1);
+      csa->map[j] = jj, csa->col[jj] = j;
+      glp_set_col_bnds(W, jj, col->type, col->lb, col->ub);
+      glp_set_obj_coef(W, jj, col->coef);
+      glp_set_sjj(W, jj, col->sjj);
+      len = 0;
+      for (aij = col->ptr; aij != NULL; aij = aij->c_next)
+         len++, ind[len] = aij->row->i, val[len] = aij->val;
+      glp_set_mat_col(W, jj, len, ind, val);
+      if (csa->rest[j] != GLP_NF)
+      {  xj = rest_value(csa, j);
+         if (xj != 0.0)
+         {  for (aij = col->ptr; aij != NULL; aij = aij->c_next)
+               csa->shift[aij->row->i] -= aij->val * xj;
+            glp_set_obj_coef(W, 0, glp_get_obj_coef(W, 0) -
+               col->coef * xj);
+         }
+      }
+      if (bs)
+         glp_set_col_stat(W, jj, GLP_BS);
+      else if (csa->rest[j] != GLP_NF)
+         glp_set_col_stat(W, jj, csa->rest[j]);
+      return;
+}
+
+/***********************************************************************
+*  set_rows - set row bounds of working LP */
+
+static void set_rows(struct csa *csa)
+{     glp_prob *P = csa->P;
+      int i;
+      double s;
+      for (i = 1; i <= P->m; i++)
+      {  s = csa->shift[i];
+         glp_set_row_bnds(csa->W, i, P->row[i]->type,
+            P->row[i]->lb - s, P->row[i]->ub - s);
+      }
+      return;
+}
+
+/***********************************************************************
+*  phase1_y - compute simplex multipliers of phase I
+*
+*  This routine computes simplex multipliers y for the sum of primal
+*  infeasibilities of the basic solution of the working LP, as the
+*  primal simplex method does in phase I, so that excluded column j
+*  prices out if its reduced cost d[j] = - sum a[i,j] * y[i] has the
+*  sign of a feasible direction. It returns non-zero if the basis
+*  factorization is not available. */
+
+static int phase1_y(struct csa *csa, double tol)
+{     glp_prob *W = csa->W;
+      int m = W->m;
+      double *y = csa->y;
+      int i, k, type;
+      double lb, ub, x;
+      if (!glp_bf_exists(W) && glp_factorize(W) != 0)
+         return 1;
+      for (i = 1; i <= m; i++)
+      {  k = glp_get_bhead(W, i);
+         if (k <= m)
+         {  type = glp_get_row_type(W, k);
+            lb = glp_get_row_lb(W, k), ub = glp_get_row_ub(W, k);
+            x = glp_get_row_prim(W, k);
+         }
+         else
+         {  type = glp_get_col_type(W, k-m);
+            lb = glp_get_col_lb(W, k-m), ub = glp_get_col_ub(W, k-m);
+            x = glp_get_col_prim(W, k-m);
+         }
+         y[i] = 0.0;
+         if ((type == GLP_LO || type == GLP_DB || type == GLP_FX) &&
+             x < lb - tol * (1.0 + fabs(lb)))
+            y[i] = -1.0;
+         if ((type == GLP_UP || type == GLP_DB || type == GLP_FX) &&
+             x > ub + tol * (1.0 + fabs(ub)))
+            y[i] = +1.0;
+      }
+      /* B' * pi = cB, where B consists of columns of (I | -A); then
+       * d[j] = c[j] + A[j]' * pi, so y = - pi */
+      glp_btran(W, y);
+      for (i = 1; i <= m; i++)
+         y[i] = - y[i];
+      return 0;
+}
+
+/***********************************************************************
+*  price - price excluded columns and add those which price out
+*
+*  This routine computes reduced costs d[j] = c[j] - sum a[i,j] * y[i]
+*  of excluded columns, where c[j] = 0 in phase I, adds to the working
+*  LP at most csa->batch columns which price out, those with largest
+*  |d[j]| first, and returns the number of columns added. */
+
+static int price(struct csa *csa, int phase, double tol, int ind[],
+      double val[])
+{     glp_prob *P = csa->P;
+      struct cand *cand = csa->cand;
+      GLPCOL *col;
+      GLPAIJ *aij;
+      int j, k, num;
+      double s, d, eps;
+      /* phase I minimizes the sum of infeasibilities */
+      s = (phase == 2 && P->dir == GLP_MAX ? -1.0 : +1.0);
+      num = 0;
+      for (j = 1; j <= P->n; j++)
+      {  if (csa->map[j] != 0 || csa->rest[j] == GLP_NS)
+            continue;
+         col = P->col[j];
+         d = (phase == 2 ? col->coef : 0.0);
+         for (aij = col->ptr; aij != NULL; aij = aij->c_next)
+            d -= aij->val * csa->y[aij->row->i];
+         d *= s;
+         eps = tol * (1.0 + (phase == 2 ? fabs(col->coef) : 0.0));
+         if (csa->rest[j] == GLP_NL ? d <= -eps : d >= +eps)
+         {  num++;
+            cand[num].j = j;
+            cand[num].score = fabs(d);
+         }
+      }
+      if (num > csa->batch)
+      {  qsort(&cand[1], num, sizeof(struct cand), fcmp);
+         num = csa->batch;
+      }
+      for (k = 1; k <= num; k++)
+         add_col(csa, cand[k].j, 0, ind, val);
+      return num;
+}
+
+/***********************************************************************
+*  store_basis - store basis of working LP to original LP */
+
+static void store_basis(struct csa *csa)
+{     glp_prob *P = csa->P;
+      int i, j;
+      for (i = 1; i <= P->m; i++)
+         glp_set_row_stat(P, i, glp_get_row_stat(csa->W, i));
+      for (j = 1; j <= P->n; j++)
+      {  if (csa->map[j] != 0)
+            glp_set_col_stat(P, j, glp_get_col_stat(csa->W,
+               csa->map[j]));
+         else
+            glp_set_col_stat(P, j, csa->rest[j]);
+      }
+      return;
+}
+
+/***********************************************************************
+*  spx_sifting - driver to sifting method
+*
+*  This routine solves the LP with the primal simplex method applied
+*  to a working LP, which has all rows of the original LP and a subset
+*  of its columns; excluded columns are kept on their bounds.
+*
+*  The working set initially consists of free columns, basic columns
+*  of the current basis, and the columns having the best objective
+*  coefficients. Every time the working LP has been solved, excluded
+*  columns are priced against its simplex multipliers, and those which
+*  price out are added to the working LP, which is then re-solved
+*  starting from its last basis, until no columns price out. If the
+*  working LP is primal infeasible, excluded columns are priced against
+*  the simplex multipliers of phase I in the same way.
+*
+*  Finally, the last basis of the working LP is completed with excluded
+*  columns and the original LP is solved with the primal simplex method
+*  starting from it. This normally takes no iterations, and computes
+*  the basic solution and the solution status of the original LP.
+*
+*  Sifting pays off only if there are many more columns than rows, so
+*  if n <= 2 * m, the routine just applies the primal simplex method to
+*  the original LP. */
+
+int spx_sifting(glp_prob *P, const glp_smcp *parm)
+{     struct csa _csa, *csa = &_csa;
+      glp_prob *W;
+      glp_smcp smcp;
+      GLPCOL *col;
+      GLPAIJ *aij;
+      int m = P->m;
+      int n = P->n;
+      int i, j, k, num, ret, round, *ind;
+      double tm_beg, xj, *val;
+      smcp = *parm;
+      smcp.meth = GLP_PRIMAL;
+      if (m == 0 || n <= 2 * m)
+         goto full;
+      /* let glp_simplex report incorrect bounds */
+      for (j = 1; j <= n; j++)
+      {  col = P->col[j];
+         if (col->type == GLP_DB && col->lb >= col->ub)
+            goto full;
+      }
+      tm_beg = xtime();
+      /* create working LP */
+      csa->P = P;
+      csa->W = W = glp_create_prob();
+      csa->map = talloc(1+n, int);
+      csa->col = talloc(1+n, int);
+      csa->rest = talloc(1+n, char);
+      csa->shift = talloc(1+m, double);
+      csa->y = talloc(1+m, double);
+      csa->cand = talloc(1+n, struct cand);
+      csa->batch = (m > SIFT_MIN ? m : SIFT_MIN);
+      ind = talloc(1+m, int);
+      val = talloc(1+m, double);
+      glp_set_obj_dir(W, P->dir);
+      glp_set_obj_coef(W, 0, P->c0);
+      glp_add_rows(W, m);
+      for (i = 1; i <= m; i++)
+      {  csa->shift[i] = 0.0;
+         glp_set_rii(W, i, P->row[i]->rii);
+      }
+      /* initially all columns are excluded and kept on their bounds */
+      for (j = 1; j <= n; j++)
+      {  col = P->col[j];
+         csa->map[j] = 0;
+         switch (col->type)
+         {  case GLP_FR:
+               csa->rest[j] = GLP_NF; break;
+            case GLP_LO:
+               csa->rest[j] = GLP_NL; break;
+            case GLP_UP:
+               csa->rest[j] = GLP_NU; break;
+            case GLP_DB:
+               csa->rest[j] = (col->stat == GLP_NU ? GLP_NU : GLP_NL);
+               break;
+            case GLP_FX:
+               csa->rest[j] = GLP_NS; break;
+            default:
+               xassert(col != col);
+         }
+         if (csa->rest[j] != GLP_NF)
+         {  xj = rest_value(csa, j);
+            if (xj != 0.0)
+            {  for (aij = col->ptr; aij != NULL; aij = aij->c_next)
+                  csa->shift[aij->row->i] += aij->val * xj;
+               glp_set_obj_coef(W, 0, glp_get_obj_coef(W, 0) +
+                  col->coef * xj);
+            }
+         }
+      }
+      /* free and basic columns form the initial working set */
+      for (j = 1; j <= n; j++)
+      {  col = P->col[j];
+         if (csa->rest[j] == GLP_NF || col->stat == GLP_BS)
+            add_col(csa, j, col->stat == GLP_BS, ind, val);
+      }
+      /* row statuses are adjusted to the row types */
+      set_rows(csa);
+      for (i = 1; i <= m; i++)
+         glp_set_row_stat(W, i, P->row[i]->stat);
+      /* and the columns having the best objective coefficients */
+      memset(&csa->y[1], 0, m * sizeof(double));
+      price(csa, 2, parm->tol_dj, ind, val);
+      /* the basis of the original LP may be invalid */
+      num = 0;
+      for (i = 1; i <= m; i++)
+         if (glp_get_row_stat(W, i) == GLP_BS) num++;
+      for (k = 1; k <= W->n; k++)
+         if (glp_get_col_stat(W, k) == GLP_BS) num++;
+      if (num != m)
+         glp_std_basis(W);
+      /* solve the working LP and add columns until none prices out */
+      if (smcp.msg_lev > GLP_MSG_ERR)
+         smcp.msg_lev = GLP_MSG_ERR;
+      smcp.presolve = GLP_OFF;
+      for (round = 1; ; round++)
+      {  set_rows(csa);
+         if (parm->it_lim < INT_MAX)
+            smcp.it_lim = parm->it_lim - W->it_cnt;
+         if (parm->tm_lim < INT_MAX)
+         {  double t = 1000.0 * xdifftime(xtime(), tm_beg);
+            smcp.tm_lim = (t >= parm->tm_lim ? 0 :
+               parm->tm_lim - (int)t);
+         }
+         ret = glp_simplex(W, &smcp);
+         if (round == 1 && (ret == GLP_ESING || ret == GLP_ECOND))
+         {  glp_std_basis(W);
+            ret = glp_simplex(W, &smcp);
+         }
+         if (ret != 0)
+         {  /* the search has been stopped; keep the last basis */
+            store_basis(csa);
+            P->pbs_stat = P->dbs_stat = GLP_UNDEF;
+            P->it_cnt += W->it_cnt;
+            goto done;
+         }
+         if (glp_get_prim_stat(W) == GLP_FEAS &&
+             glp_get_dual_stat(W) == GLP_FEAS)
+         {  /* optimal; price against the simplex multipliers */
+            for (i = 1; i <= m; i++)
+               csa->y[i] = glp_get_row_dual(W, i);
+            num = price(csa, 2, parm->tol_dj, ind, val);
+         }
+         else if (glp_get_prim_stat(W) == GLP_NOFEAS &&
+             phase1_y(csa, parm->tol_bnd) == 0)
+         {  /* infeasible; price against the multipliers of phase I */
+            num = price(csa, 1, parm->tol_dj, ind, val);
+         }
+         else
+         {  /* unbounded (so is the original LP) or undecided */
+            num = 0;
+         }
+         if (parm->msg_lev >= GLP_MSG_ON)
+            xprintf("Sifting: round %d: %d of %d columns, obj = %.9e, "
+               "%s; %d added\n", round, W->n - num, n,
+               glp_get_obj_val(W), glp_get_prim_stat(W) == GLP_FEAS ?
+               "feas" : "infeas", num);
+         if (num == 0)
+            break;
+      }
+      /* solve the original LP starting from the last basis */
+      store_basis(csa);
+      P->it_cnt += W->it_cnt;
+      smcp = *parm;
+      smcp.meth = GLP_PRIMAL;
+      smcp.presolve = GLP_OFF;
+      if (parm->it_lim < INT_MAX)
+         smcp.it_lim = (W->it_cnt >= parm->it_lim ? 0 :
+            parm->it_lim - W->it_cnt);
+      if (parm->tm_lim < INT_MAX)
+      {  double t = 1000.0 * xdifftime(xtime(), tm_beg);
+         smcp.tm_lim = (t >= parm->tm_lim ? 0 : parm->tm_lim - (int)t);
+      }
+      ret = glp_simplex(P, &smcp);
+done: glp_delete_prob(W);
+      tfree(csa->map);
+      tfree(csa->col);
+      tfree(csa->rest);
+      tfree(csa->shift);
+      tfree(csa->y);
+      tfree(csa->cand);
+      tfree(ind);
+      tfree(val);
+      return ret;
+full: /* solve the original LP directly */
+      return glp_simplex(P, &smcp);
+}
+
+/* eof */
@@ -0,0 +1,345 @@
+/* spxsimd.c */
+
+/***********************************************************************
+*  This code is part of GLPK (GNU Linear Programming Kit).
+*
+*  GLPK is free software: you can redistribute it and/or modify it
+*  under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  GLPK is distributed in the hope that it will be useful, but WITHOUT
+*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+*  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+*  License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with GLPK. If not, see <http://www.gnu.org/licenses/>.
+***********************************************************************/
+
+/* the kernels are compiled for their instruction sets with function
+ * attributes, so that the rest of the library keeps the baseline ones;
+ * gcc 5 and clang are needed for that and for __builtin_cpu_supports */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) \
+   && (__GNUC__ >= 5 || defined(__clang__))
+#define SPX_X86 1
+#include <immintrin.h>
+#endif
+
+#include "glpenv.h"
+#include "spxsimd.h"
+
+/***********************************************************************
+*  spx_simd - determine the best kernel variant for the processor
+*
+*  This routine returns SPX_SIMD_AVX512 if the processor and operating
+*  system support AVX-512F, SPX_SIMD_AVX2 if they support AVX2, and
+*  SPX_SIMD_OFF otherwise, or if the library is not compiled for x86
+*  with gcc or clang. */
+
+int spx_simd(void)
+{
+#ifdef SPX_X86
+      if (__builtin_cpu_supports("avx512f"))
+         return SPX_SIMD_AVX512;
+      if (__builtin_cpu_supports("avx2"))
+         return SPX_SIMD_AVX2;
+#endif
+      return SPX_SIMD_OFF;
+}
+
+#ifdef SPX_X86
+
+/* The kernels must round exactly as the scalar code does, so that the
+ * choice of variant does not change the pivoting:
+ *
+ * - every element of the result is accumulated in the same order as
+ *   in the scalar loops; the elements of y updated with one row of the
+ *   matrix are distinct, and the inner products are computed for
+ *   several columns at once, one column per lane;
+ *
+ * - multiplication and addition are never fused: AVX2 is enabled
+ *   without FMA, and the AVX-512 code uses the explicit rounding forms
+ *   of the intrinsics, which the compiler does not contract. */
+
+#define AVX2 __attribute__((target("avx2")))
+#define AVX512 __attribute__((target("avx512f")))
+#define CUR _MM_FROUND_CUR_DIRECTION
+
+/***********************************************************************
+*  axpy_avx2 - compute y := y + t * a with AVX2
+*
+*  AVX2 has gathers, but no scatters: four updated elements of y are
+*  computed at once and stored one by one. This is also used when the
+*  processor supports AVX-512F, whose scatters were measured to be
+*  slower than the scalar stores. */
+
+static AVX2 void axpy_avx2(int len, const int ind[], const double val[],
+      double t, double y[])
+{     int k;
+      double buf[4];
+      __m256d tt, yy;
+      tt = _mm256_set1_pd(t);
+      for (k = 0; k + 4 <= len; k += 4)
+      {  yy = _mm256_i32gather_pd(y,
+            _mm_loadu_si128((const __m128i *)&ind[k]), 8);
+         yy = _mm256_add_pd(yy,
+            _mm256_mul_pd(_mm256_loadu_pd(&val[k]), tt));
+         _mm256_storeu_pd(buf, yy);
+         y[ind[k]] = buf[0];
+         y[ind[k+1]] = buf[1];
+         y[ind[k+2]] = buf[2];
+         y[ind[k+3]] = buf[3];
+      }
+      for (; k < len; k++)
+         y[ind[k]] += val[k] * t;
+      return;
+}
+
+/***********************************************************************
+*  cols_avx2 - compute inner products with columns of N with AVX2
+*
+*  Four columns of N are processed at once, one per lane; a lane stops
+*  accumulating when its column is exhausted. */
+
+static AVX2 void cols_avx2(int m, int len, const int list[],
+      const int A_ptr[], const int A_ind[], const double A_val[],
+      const int head[], const double rho[], double trow[])
+{     int p, q, k, cur[4], last[4];
+      double buf[4];
+      __m128i pp, ee, live, kk;
+      __m256d mask, aa, rr, tt;
+      const __m256d zero = _mm256_setzero_pd();
+      for (p = 1; p <= len; p += 4)
+      {  /* lanes past the end of the list stay empty */
+         for (q = 0; q < 4; q++)
+         {  if (p + q <= len)
+            {  k = head[m+list[p+q]]; /* x[k] = xN[list[p+q]] */
+               cur[q] = A_ptr[k];
+               last[q] = A_ptr[k+1];
+            }
+            else
+               cur[q] = last[q] = 0;
+         }
+         pp = _mm_loadu_si128((const __m128i *)cur);
+         ee = _mm_loadu_si128((const __m128i *)last);
+         tt = zero;
+         for (;;)
+         {  live = _mm_cmpgt_epi32(ee, pp);
+            if (_mm_movemask_epi8(live) == 0)
+               break;
+            mask = _mm256_castsi256_pd(_mm256_cvtepi32_epi64(live));
+            kk = _mm_mask_i32gather_epi32(_mm_setzero_si128(), A_ind,
+               pp, live, 4);
+            aa = _mm256_mask_i32gather_pd(zero, A_val, pp, mask, 8);
+            rr = _mm256_mask_i32gather_pd(zero, rho, kk, mask, 8);
+            /* empty lanes subtract +0, which leaves them unchanged */
+            tt = _mm256_sub_pd(tt, _mm256_mul_pd(aa, rr));
+            /* live lanes are all ones, i.e. -1 */
+            pp = _mm_sub_epi32(pp, live);
+         }
+         _mm256_storeu_pd(buf, tt);
+         for (q = 0; q < 4 && p + q <= len; q++)
+            trow[list[p+q]] = buf[q];
+      }
+      return;
+}
+
+/***********************************************************************
+*  cols_avx512 - compute inner products with columns of N with AVX-512F
+*
+*  Sixteen columns of N are processed at once, one per lane of the
+*  position vector, which is split in two halves for the gathers of
+*  the double precision elements. */
+
+static AVX512 void cols_avx512(int m, int len, const int list[],
+      const int A_ptr[], const int A_ind[], const double A_val[],
+      const int head[], const double rho[], double trow[])
+{     int p, q, k, cur[16], last[16];
+      double buf[16];
+      __mmask16 live;
+      __mmask8 lo, hi;
+      __m512i pp, ee, kk;
+      __m512d t1, t2, aa, rr;
+      const __m512i one = _mm512_set1_epi32(1);
+      const __m512d zero = _mm512_setzero_pd();
+      for (p = 1; p <= len; p += 16)
+      {  /* lanes past the end of the list stay empty */
+         for (q = 0; q < 16; q++)
+         {  if (p + q <= len)
+            {  k = head[m+list[p+q]]; /* x[k] = xN[list[p+q]] */
+               cur[q] = A_ptr[k];
+               last[q] = A_ptr[k+1];
+            }
+            else
+               cur[q] = last[q] = 0;
+         }
+         pp = _mm512_loadu_si512(cur);
+         ee = _mm512_loadu_si512(last);
+         t1 = t2 = zero;
+         for (;;)
+         {  live = _mm512_cmpgt_epi32_mask(ee, pp);
+            if (live == 0)
+               break;
+            lo = (__mmask8)live;
+            hi = (__mmask8)(live >> 8);
+            kk = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(),
+               live, pp, A_ind, 4);
+            aa = _mm512_mask_i32gather_pd(zero, lo,
+               _mm512_castsi512_si256(pp), A_val, 8);
+            rr = _mm512_mask_i32gather_pd(zero, lo,
+               _mm512_castsi512_si256(kk), rho, 8);
+            t1 = _mm512_mask_sub_round_pd(t1, lo, t1,
+               _mm512_mul_round_pd(aa, rr, CUR), CUR);
+            aa = _mm512_mask_i32gather_pd(zero, hi,
+               _mm512_extracti64x4_epi64(pp, 1), A_val, 8);
+            rr = _mm512_mask_i32gather_pd(zero, hi,
+               _mm512_extracti64x4_epi64(kk, 1), rho, 8);
+            t2 = _mm512_mask_sub_round_pd(t2, hi, t2,
+               _mm512_mul_round_pd(aa, rr, CUR), CUR);
+            pp = _mm512_mask_add_epi32(pp, live, pp, one);
+         }
+         _mm512_storeu_pd(&buf[0], t1);
+         _mm512_storeu_pd(&buf[8], t2);
+         for (q = 0; q < 16 && p + q <= len; q++)
+            trow[list[p+q]] = buf[q];
+      }
+      return;
+}
+
+/***********************************************************************
+*  dse_avx2 - update dual steepest edge weights with AVX2
+*
+*  Four weights are updated at once. The flags of the reference space
+*  are bytes selected through the basis header, they are gathered one
+*  by one. */
+
+static AVX2 void dse_avx2(int beg, int end, const int head[],
+      const char refsp[], const double tcol[], double tcol_p,
+      double gamma_p, double delta_p, const double u[], double gamma[])
+{     int i;
+      __m256d pp, gp, dp, r, uu, t1, t2;
+      pp = _mm256_set1_pd(tcol_p);
+      gp = _mm256_set1_pd(gamma_p);
+      dp = _mm256_set1_pd(delta_p);
+      for (i = beg; i + 4 <= end + 1; i += 4)
+      {  r = _mm256_div_pd(_mm256_loadu_pd(&tcol[i]), pp);
+         uu = _mm256_loadu_pd(&u[i]);
+         /* t1 = gamma[i] + r * (r * gamma_p + u[i] + u[i]) */
+         t1 = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(r, gp), uu), uu);
+         t1 = _mm256_add_pd(_mm256_loadu_pd(&gamma[i]),
+            _mm256_mul_pd(r, t1));
+         /* t2 = (refsp ? 1 : 0) + delta_p * r * r */
+         t2 = _mm256_set_pd(refsp[head[i+3]] ? 1.0 : 0.0,
+            refsp[head[i+2]] ? 1.0 : 0.0, refsp[head[i+1]] ? 1.0 : 0.0,
+            refsp[head[i]] ? 1.0 : 0.0);
+         t2 = _mm256_add_pd(t2, _mm256_mul_pd(_mm256_mul_pd(dp, r), r));
+         /* t1 >= t2 ? t1 : t2, also if either is NaN */
+         _mm256_storeu_pd(&gamma[i], _mm256_blendv_pd(t2, t1,
+            _mm256_cmp_pd(t1, t2, _CMP_GE_OQ)));
+      }
+      for (; i <= end; i++)
+      {  double ri, s1, s2;
+         ri = tcol[i] / tcol_p;
+         s1 = gamma[i] + ri * (ri * gamma_p + u[i] + u[i]);
+         s2 = (refsp[head[i]] ? 1.0 : 0.0) + delta_p * ri * ri;
+         gamma[i] = (s1 >= s2 ? s1 : s2);
+      }
+      return;
+}
+
+#endif
+
+/***********************************************************************
+*  spx_simd_axpy - compute y := y + t * a
+*
+*  This routine computes y[ind[k]] := y[ind[k]] + t * val[k] for
+*  k = 0, ..., len-1, where the indices ind[k] are distinct, with the
+*  kernel variant simd (SPX_SIMD_AVX2 or SPX_SIMD_AVX512) returned by
+*  the routine spx_simd. The routines spx_at_prod and spx_nt_prod use
+*  it for rows having at least SPX_SIMD_LEN non-zeros, and the routine
+*  spy_update_gamma for such columns. */
+
+void spx_simd_axpy(int simd, int len, const int ind[],
+      const double val[], double t, double y[])
+{     switch (simd)
+      {
+#ifdef SPX_X86
+         case SPX_SIMD_AVX2:
+         case SPX_SIMD_AVX512:
+            axpy_avx2(len, ind, val, t, y);
+            break;
+#endif
+         default:
+            xassert(simd != simd);
+      }
+      return;
+}
+
+/***********************************************************************
+*  spx_simd_cols - compute inner products with columns of N
+*
+*  This routine computes trow[j] = - N'[j] * rho for the columns of N
+*  listed in locations list[1], ..., list[len], as the routine
+*  spx_eval_trow1 does, with the kernel variant simd (SPX_SIMD_AVX2 or
+*  SPX_SIMD_AVX512) returned by the routine spx_simd. The routines
+*  spx_eval_trow1 and spx_update_gamma use it for columns having at
+*  least SPX_SIMD_LEN non-zeros. */
+
+void spx_simd_cols(int simd, int m, int len, const int list[],
+      const int A_ptr[], const int A_ind[], const double A_val[],
+      const int head[], const double rho[], double trow[])
+{     switch (simd)
+      {
+#ifdef SPX_X86
+         case SPX_SIMD_AVX2:
+            cols_avx2(m, len, list, A_ptr, A_ind, A_val, head, rho,
+               trow);
+            break;
+         case SPX_SIMD_AVX512:
+            cols_avx512(m, len, list, A_ptr, A_ind, A_val, head, rho,
+               trow);
+            break;
+#endif
+         default:
+            xassert(simd != simd);
+      }
+      return;
+}
+
+/***********************************************************************
+*  spx_simd_dse - update dual steepest edge weights
+*
+*  This routine computes, for i = beg, ..., end:
+*
+*     r = tcol[i] / tcol_p,
+*
+*     t1 = gamma[i] + r * (r * gamma_p + u[i] + u[i]),
+*
+*     t2 = (refsp[head[i]] ? 1 : 0) + delta_p * r * r,
+*
+*     gamma[i] = max(t1, t2),
+*
+*  as the routine spy_update_gamma does, with the kernel variant simd
+*  (SPX_SIMD_AVX2 or SPX_SIMD_AVX512) returned by the routine
+*  spx_simd. */
+
+void spx_simd_dse(int simd, int beg, int end, const int head[],
+      const char refsp[], const double tcol[], double tcol_p,
+      double gamma_p, double delta_p, const double u[], double gamma[])
+{     switch (simd)
+      {
+#ifdef SPX_X86
+         case SPX_SIMD_AVX2:
+         case SPX_SIMD_AVX512:
+            dse_avx2(beg, end, head, refsp, tcol, tcol_p, gamma_p,
+               delta_p, u, gamma);
+            break;
+#endif
+         default:
+            xassert(simd != simd);
+      }
+      return;
+}
+
+/* eof */
@@ -0,0 +1,60 @@
+/* spxsimd.h */
+
+/***********************************************************************
+*  This code is part of GLPK (GNU Linear Programming Kit).
+*
+*  GLPK is free software: you can redistribute it and/or modify it
+*  under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  GLPK is distributed in the hope that it will be useful, but WITHOUT
+*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+*  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+*  License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with GLPK. If not, see <http://www.gnu.org/licenses/>.
+***********************************************************************/
+
+#ifndef SPXSIMD_H
+#define SPXSIMD_H
+
+/* vectorised variants of the sparse matrix-vector products used to
+ * compute rows of the simplex table, and of the steepest edge weight
+ * updates; they are selected at run time depending on the instruction
+ * sets the processor supports, and give results bitwise identical to
+ * the scalar code */
+
+#define SPX_SIMD_OFF    0  /* scalar code */
+#define SPX_SIMD_AVX2   1  /* AVX2 */
+#define SPX_SIMD_AVX512 2  /* AVX-512F */
+
+#define spx_simd _glp_spx_simd
+int spx_simd(void);
+/* determine the best kernel variant for the processor */
+
+#define SPX_SIMD_LEN 8
+/* the kernels are used for rows and columns having at least this
+ * number of non-zeros; shorter ones are faster with the scalar code */
+
+#define spx_simd_axpy _glp_spx_simd_axpy
+void spx_simd_axpy(int simd, int len, const int ind[],
+      const double val[], double t, double y[]);
+/* compute y := y + t * a, a in sparse format */
+
+#define spx_simd_cols _glp_spx_simd_cols
+void spx_simd_cols(int simd, int m, int len, const int list[],
+      const int A_ptr[], const int A_ind[], const double A_val[],
+      const int head[], const double rho[], double trow[]);
+/* compute inner products with columns of N */
+
+#define spx_simd_dse _glp_spx_simd_dse
+void spx_simd_dse(int simd, int beg, int end, const int head[],
+      const char refsp[], const double tcol[], double tcol_p,
+      double gamma_p, double delta_p, const double u[], double gamma[]);
+/* update dual steepest edge weights */
+
+#endif
+
+/* eof */
@@ -219,4 +219,131 @@ int spy_chuzc_harris(SPXLP *lp, const double d[/*1+n-m*/],
 done: return q;
 }
 
+static int fcmp(const void *ptr1, const void *ptr2)
+{     /* this routine is passed to the qsort() function */
+      SPYBP *bp1 = (void *)ptr1, *bp2 = (void *)ptr2;
+      if (bp1->teta < bp2->teta) return -1;
+      if (bp1->teta > bp2->teta) return +1;
+      /* larger pivots first on ties */
+      if (bp1->alfa > bp2->alfa) return -1;
+      if (bp1->alfa < bp2->alfa) return +1;
+      return 0;
+}
+
+/***********************************************************************
+*  spy_chuzc_flip - choose non-basic var. (dual long-step ratio test)
+*
+*  This routine implements the dual long-step (bound flipping) ratio
+*  test to choose non-basic variable xN[q].
+*
+*  The parameters d, s, trow and tol_piv, as well as the returned value
+*  have the same meaning as for the routine spy_chuzc_std (see above).
+*  The parameters tol and tol1 specify tolerances on zero bound
+*  violations for reduced costs as for the routine spy_chuzc_harris.
+*
+*  The parameter slope specifies the initial slope of the dual
+*  objective along the dual ray, which is the magnitude of the bound
+*  violation of basic variable xB[p] chosen, slope > 0.
+*
+*  The textbook ratio test stops at the first break point, where some
+*  dual basic variable lambdaN[j] reaches its zero bound. However, if
+*  xN[j] is double-bounded, the dual ray may pass that break point,
+*  provided xN[j] is moved to its opposite bound, so the sign of
+*  lambdaN[j] remains correct. This decreases the slope by
+*  |t[p,j]| * (uN[j] - lN[j]), and the routine passes break points in
+*  ascending order of theta while the slope remains positive. It stops
+*  at the first break point, where the slope would become non-positive
+*  or whose variable is not double-bounded; then, to avoid small
+*  pivots, it chooses among this and the following break points, which
+*  are not farther than the nearest relaxed zero bound, the one with
+*  the largest |t[p,j]|, as the Harris' ratio test does.
+*
+*  On exit the routine stores the break points in ascending order of
+*  theta to the array locations bp[1], ..., bp[num], and the number of
+*  break points passed to the location nflip. Thus, bp[t].j for t = 1,
+*  ..., nflip are indices j of non-basic variables xN[j] which should
+*  be moved to their opposite bounds. */
+
+int spy_chuzc_flip(SPXLP *lp, const double d[/*1+n-m*/],
+      double s, const double trow[/*1+n-m*/], double tol_piv,
+      double tol, double tol1, double slope, SPYBP bp[/*1+n-m*/],
+      int *nflip)
+{     int m = lp->m;
+      int n = lp->n;
+      double *c = lp->c;
+      double *l = lp->l;
+      double *u = lp->u;
+      int *head = lp->head;
+      char *flag = lp->flag;
+      int j, k, q, t, tq, num;
+      double alfa, biga, delta, teta_max;
+      xassert(s == +1.0 || s == -1.0);
+      xassert(slope > 0.0);
+      /* determine break points */
+      num = 0;
+      for (j = 1; j <= n-m; j++)
+      {  k = head[m+j]; /* x[k] = xN[j] */
+         /* if xN[j] is fixed variable, skip it */
+         if (l[k] == u[k])
+            continue;
+         alfa = s * trow[j];
+         if (alfa >= +tol_piv && !flag[j])
+         {  /* xN[j] is either free or has its lower bound active, so
+             * lambdaN[j] = d[j] >= 0 decreases down to zero */
+            delta = tol + tol1 * (c[k] >= 0.0 ? +c[k] : -c[k]);
+            num++;
+            bp[num].teta = (d[j] < 0.0 ? 0.0 : d[j]) / alfa;
+            bp[num].tetx = ((d[j] < 0.0 ? 0.0 : d[j]) + delta) / alfa;
+         }
+         else if (alfa <= -tol_piv && (l[k] == -DBL_MAX || flag[j]))
+         {  /* xN[j] is either free or has its upper bound active, so
+             * lambdaN[j] = d[j] <= 0 increases up to zero */
+            delta = tol + tol1 * (c[k] >= 0.0 ? +c[k] : -c[k]);
+            num++;
+            bp[num].teta = (d[j] > 0.0 ? 0.0 : d[j]) / alfa;
+            bp[num].tetx = ((d[j] > 0.0 ? 0.0 : d[j]) - delta) / alfa;
+         }
+         else
+         {  /* lambdaN[j] cannot reach zero on increasing theta */
+            continue;
+         }
+         bp[num].j = j;
+         bp[num].alfa = (alfa >= 0.0 ? +alfa : -alfa);
+      }
+      *nflip = 0;
+      if (num == 0)
+      {  /* theta may increase unlimitedly */
+         q = 0;
+         goto done;
+      }
+      /* sort break points in ascending order of theta */
+      qsort(&bp[1], num, sizeof(SPYBP), fcmp);
+      /* pass break points while the slope remains positive */
+      for (tq = 1; tq < num; tq++)
+      {  k = head[m+bp[tq].j]; /* x[k] = xN[j] */
+         if (l[k] == -DBL_MAX || u[k] == +DBL_MAX)
+            break;
+         slope -= bp[tq].alfa * (u[k] - l[k]);
+         if (slope <= 0.0)
+            break;
+      }
+      /* the break points passed are flipped */
+      *nflip = tq - 1;
+      /* choose the largest pivot among the remaining break points,
+       * whose theta does not exceed the nearest relaxed zero bound */
+      teta_max = DBL_MAX;
+      for (t = tq; t <= num; t++)
+      {  if (teta_max > bp[t].tetx)
+            teta_max = bp[t].tetx;
+      }
+      q = 0, biga = 0.0;
+      for (t = tq; t <= num && bp[t].teta <= teta_max; t++)
+      {  if (biga < bp[t].alfa)
+            q = bp[t].j, biga = bp[t].alfa;
+      }
+      /* something must be chosen */
+      xassert(1 <= q && q <= n-m);
+done: return q;
+}
+
 /* eof */
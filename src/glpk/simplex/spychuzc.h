@@ -38,6 +38,28 @@ int spy_chuzc_harris(SPXLP *lp, const double d[/*1+n-m*/],
       double tol, double tol1);
 /* choose non-basic variable (dual Harris' ratio test) */
 
+typedef struct SPYBP SPYBP;
+
+struct SPYBP
+{     /* break point of the dual objective along the dual ray */
+      int j;
+      /* dual basic variable lambdaN[j] reaches its zero bound at this
+       * break point */
+      double teta;
+      /* value of the dual ray parameter at this break point */
+      double tetx;
+      /* the same value for the relaxed zero bound */
+      double alfa;
+      /* |t[p,j]|, magnitude of the simplex table element */
+};
+
+#define spy_chuzc_flip _glp_spy_chuzc_flip
+int spy_chuzc_flip(SPXLP *lp, const double d[/*1+n-m*/],
+      double s, const double trow[/*1+n-m*/], double tol_piv,
+      double tol, double tol1, double slope, SPYBP bp[/*1+n-m*/],
+      int *nflip);
+/* choose non-basic variable (dual long-step ratio test) */
+
 #endif
 
 /* eof */
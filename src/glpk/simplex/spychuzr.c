@@ -165,6 +165,7 @@ void spy_alloc_se(SPXLP *lp, SPYSE *se)
       se->refsp = talloc(1+n, char);
       se->gamma = talloc(1+m, double);
       se->work = talloc(1+m, double);
+      se->simd = spx_simd();
       return;
 }
 
@@ -336,7 +337,10 @@ int spy_chuzr_pse(SPXLP *lp, SPYSE *se, const double beta[/*1+m*/],
 *  non-basic variable corresponding to xB[p]) on entry to the routine,
 *  and returns e on exit. (If e happens to be large enough, the calling
 *  program may reset the reference space, since other weights also may
-*  be inaccurate.) */
+*  be inaccurate.)
+*
+*  The weights gamma[i], i != p, are updated by the vectorised kernel
+*  se->simd, unless it is SPX_SIMD_OFF; the results are the same. */
 
 double spy_update_gamma(SPXLP *lp, SPYSE *se, int p, int q,
       const double trow[/*1+n-m*/], const double tcol[/*1+m*/])
@@ -365,27 +369,38 @@ double spy_update_gamma(SPXLP *lp, SPYSE *se, int p, int q,
              * matrix column corresponding to xN[j] */
             ptr = lp->A_ptr[k];
             end = lp->A_ptr[k+1];
-            for (; ptr < end; ptr++)
-               u[lp->A_ind[ptr]] += trow[j] * lp->A_val[ptr];
+            if (se->simd != SPX_SIMD_OFF && end - ptr >= SPX_SIMD_LEN)
+               spx_simd_axpy(se->simd, end - ptr, &lp->A_ind[ptr],
+                  &lp->A_val[ptr], trow[j], u);
+            else
+            {  for (; ptr < end; ptr++)
+                  u[lp->A_ind[ptr]] += trow[j] * lp->A_val[ptr];
+            }
          }
       }
       bfd_ftran(lp->bfd, u);
       /* compute relative error in gamma[p] */
       e = fabs(gamma_p - gamma[p]) / (1.0 + gamma_p);
+      /* compute new gamma[i] for all i != p; the vectorised kernel
+       * also computes gamma[p], which is replaced below */
+      if (se->simd != SPX_SIMD_OFF)
+         spx_simd_dse(se->simd, 1, m, head, refsp, tcol, tcol[p],
+            gamma_p, delta_p, u, gamma);
+      else
+      {  for (i = 1; i <= m; i++)
+         {  if (i == p)
+               continue;
+            /* compute r[i] = T[i,q] / T[p,q] */
+            r = tcol[i] / tcol[p];
+            /* compute new gamma[i] */
+            t1 = gamma[i] + r * (r * gamma_p + u[i] + u[i]);
+            k = head[i]; /* x[k] = xB[i] */
+            t2 = (refsp[k] ? 1.0 : 0.0) + delta_p * r * r;
+            gamma[i] = (t1 >= t2 ? t1 : t2);
+         }
+      }
       /* compute new gamma[p] */
       gamma[p] = gamma_p / (tcol[p] * tcol[p]);
-      /* compute new gamma[i] for all i != p */
-      for (i = 1; i <= m; i++)
-      {  if (i == p)
-            continue;
-         /* compute r[i] = T[i,q] / T[p,q] */
-         r = tcol[i] / tcol[p];
-         /* compute new gamma[i] */
-         t1 = gamma[i] + r * (r * gamma_p + u[i] + u[i]);
-         k = head[i]; /* x[k] = xB[i] */
-         t2 = (refsp[k] ? 1.0 : 0.0) + delta_p * r * r;
-         gamma[i] = (t1 >= t2 ? t1 : t2);
-      }
       return e;
 }
 
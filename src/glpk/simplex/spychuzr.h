@@ -25,6 +25,7 @@
 #define SPYCHUZR_H
 
 #include "spxlp.h"
+#include "spxsimd.h"
 
 #define spy_chuzr_sel _glp_spy_chuzr_sel
 int spy_chuzr_sel(SPXLP *lp, const double beta[/*1+m*/], double tol,
@@ -53,6 +54,11 @@ struct SPYSE
        * (r[i] is bound violation for basic variable xB[i]) */
       double *work; /* double work[1+m]; */
       /* working array */
+      int simd;
+      /* variant of the kernels updating the weights, SPX_SIMD_OFF for
+       * the scalar code (see spxsimd.h); set by spy_alloc_se to the
+       * best variant for the processor, the calling program may change
+       * it */
 };
 
 #define spy_alloc_se _glp_spy_alloc_se
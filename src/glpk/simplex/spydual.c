@@ -101,6 +101,15 @@ struct csa
       /* xN[q] is a non-basic variable chosen to enter the basis */
       double *tcol; /* double tcol[1+m]; */
       /* q-th (pivot) column of the simplex table */
+      SPYBP *bp; /* SPYBP bp[1+n-m]; */
+      /* break points of the dual objective (NULL if the long-step
+       * ratio test is not used) */
+      int nflip;
+      /* number of non-basic variables moved to their opposite bounds
+       * along with the basis change */
+      int *flip; /* int flip[1+n-m]; */
+      /* flip[1], ..., flip[nflip] are indices j of such non-basic
+       * variables xN[j] (long-step ratio test) */
       double *work; /* double work[1+m]; */
       /* working array */
       double *work1; /* double work1[1+n-m]; */
@@ -113,10 +122,11 @@ struct csa
       /* message level */
       int dualp;
       /* if this flag is set, report failure in case of instability */
-      int harris;
+      int r_test;
       /* dual ratio test technique:
-       * 0 - textbook ratio test
-       * 1 - Harris' two pass ratio test */
+       * GLP_RT_STD  - textbook ratio test
+       * GLP_RT_HAR  - Harris' two pass ratio test
+       * GLP_RT_FLIP - long-step (bound flipping) ratio test */
       double tol_bnd, tol_bnd1;
       /* primal feasibility tolerances */
       double tol_dj, tol_dj1;
@@ -129,6 +139,8 @@ struct csa
       /* iteration limit */
       int tm_lim;
       /* time limit, milliseconds */
+      volatile int *abort;
+      /* the search is cancelled once *abort is non-zero */
       int out_frq;
       /* display output frequency, iterations */
       int out_dly;
@@ -146,6 +158,17 @@ struct csa
       /* simplex iteration count at most recent display output */
       int inv_cnt;
       /* basis factorization count since most recent display output */
+      int refct;
+      /* number of steepest edge weight updates left before the
+       * reference space is reset */
+      int it_run;
+      /* simplex iteration count at the beginning of the current run */
+      int it_yld;
+      /* the search is suspended once it_cnt reaches it_yld (0 means no
+       * iteration budget) */
+      double tm_yld;
+      /* the search is suspended once the time value reaches tm_yld
+       * (0 means no time budget) */
 };
 
 /***********************************************************************
@@ -511,6 +534,7 @@ static void choose_pivot(struct csa *csa)
       int m = lp->m;
       int n = lp->n;
       double *l = lp->l;
+      double *u = lp->u;
       int *head = lp->head;
       SPXAT *at = csa->at;
       SPXNT *nt = csa->nt;
@@ -520,13 +544,14 @@ static void choose_pivot(struct csa *csa)
       int *list = csa->list;
       double *rho = csa->work;
       double *trow = csa->work1;
-      int nnn, try, k, p, q, t;
+      int nnn, try, k, p, q, t, nflip;
       xassert(csa->beta_st);
       xassert(csa->d_st);
       /* initial number of eligible basic variables */
       nnn = csa->num;
       /* nothing has been chosen so far */
       csa->p = 0;
+      csa->nflip = nflip = 0;
       try = 0;
 try:  /* choose basic variable xB[p] */
       xassert(nnn > 0);
@@ -549,12 +574,17 @@ try:  /* choose basic variable xB[p] */
          spx_nt_prod(lp, nt, trow, 1, -1.0, rho);
       /* choose non-basic variable xN[q] */
       k = head[p]; /* x[k] = xB[p] */
-      if (!csa->harris)
+      if (csa->r_test == GLP_RT_STD)
          q = spy_chuzc_std(lp, d, beta[p] < l[k] ? +1. : -1., trow,
             csa->tol_piv, .30 * csa->tol_dj, .30 * csa->tol_dj1);
-      else
+      else if (csa->r_test == GLP_RT_HAR)
          q = spy_chuzc_harris(lp, d, beta[p] < l[k] ? +1. : -1., trow,
             csa->tol_piv, .35 * csa->tol_dj, .35 * csa->tol_dj1);
+      else
+         q = spy_chuzc_flip(lp, d, beta[p] < l[k] ? +1. : -1., trow,
+            csa->tol_piv, .35 * csa->tol_dj, .35 * csa->tol_dj1,
+            beta[p] < l[k] ? l[k] - beta[p] : beta[p] - u[k],
+            csa->bp, &nflip);
       /* either keep previous choice or accept new choice depending on
        * which one is better */
       if (csa->p == 0 || q == 0 ||
@@ -562,6 +592,10 @@ try:  /* choose basic variable xB[p] */
       {  csa->p = p;
          memcpy(&csa->trow[1], &trow[1], (n-m) * sizeof(double));
          csa->q = q;
+         /* non-basic variables whose break points have been passed */
+         csa->nflip = (q == 0 ? 0 : nflip);
+         for (t = 1; t <= csa->nflip; t++)
+            csa->flip[t] = csa->bp[t].j;
       }
       /* check if current choice is acceptable */
       if (csa->q == 0 || fabs(csa->trow[csa->q]) >= 0.001)
@@ -585,6 +619,63 @@ done: /* the choice has been made */
       return;
 }
 
+/***********************************************************************
+*  flip_bounds - move non-basic variables to their opposite bounds
+*
+*  This routine moves non-basic variables xN[j], whose break points
+*  have been passed by the long-step ratio test, to their opposite
+*  bounds and updates values of basic variables accordingly:
+*
+*     new beta = beta - inv(B) * sum N[j] * delta xN[j],
+*
+*  which takes one forward transformation for all such variables. It
+*  is called before the basis change, so that the routine
+*  spx_update_beta then computes the value of xN[q] entering the basis
+*  for the new values of basic variables. */
+
+static void flip_bounds(struct csa *csa)
+{     SPXLP *lp = csa->lp;
+      int m = lp->m;
+      int *A_ptr = lp->A_ptr;
+      int *A_ind = lp->A_ind;
+      double *A_val = lp->A_val;
+      double *l = lp->l;
+      double *u = lp->u;
+      int *head = lp->head;
+      char *flag = lp->flag;
+      double *beta = csa->beta;
+      double *y = csa->work;
+      int i, j, k, t, ptr, end;
+      double delta;
+      /* y := sum N[j] * delta xN[j] */
+      memset(&y[1], 0, m * sizeof(double));
+      for (t = 1; t <= csa->nflip; t++)
+      {  j = csa->flip[t];
+         k = head[m+j]; /* x[k] = xN[j] */
+         /* xN[j] should be double-bounded variable */
+         xassert(l[k] != -DBL_MAX && u[k] != +DBL_MAX && l[k] != u[k]);
+         if (flag[j])
+         {  /* xN[j] goes from its upper bound to its lower bound */
+            delta = l[k] - u[k];
+         }
+         else
+         {  /* xN[j] goes from its lower bound to its upper bound */
+            delta = u[k] - l[k];
+         }
+         flag[j] = (char)(1 - flag[j]);
+         ptr = A_ptr[k];
+         end = A_ptr[k+1];
+         for (; ptr < end; ptr++)
+            y[A_ind[ptr]] += A_val[ptr] * delta;
+      }
+      /* beta := beta - inv(B) * y */
+      bfd_ftran(lp->bfd, y);
+      for (i = 1; i <= m; i++)
+         beta[i] -= y[i];
+      csa->nflip = 0;
+      return;
+}
+
 /***********************************************************************
 *  display - display search progress
 *
@@ -711,6 +802,9 @@ skip: return;
 *  GLP_ETMLIM
 *     Time limit has been exhausted.
 *
+*  GLP_ECANCEL
+*     The search has been cancelled by the application.
+*
 *  GLP_EFAIL
 *     The solver failed to solve LP instance. */
 
@@ -735,7 +829,7 @@ static int dual_simplex(struct csa *csa)
       double tol_bnd1 = csa->tol_bnd1;
       double tol_dj = csa->tol_dj;
       double tol_dj1 = csa->tol_dj1;
-      int j, k, p_flag, refct, ret;
+      int j, k, p_flag, ret;
       check_flags(csa);
 loop: /* main loop starts here */
       /* compute factorization of the basis matrix */
@@ -834,7 +928,7 @@ loop: /* main loop starts here */
       }
       /* reset the dual reference space, if necessary */
       if (se != NULL && !se->valid)
-         spy_reset_refsp(lp, se), refct = 1000;
+         spy_reset_refsp(lp, se), csa->refct = 1000;
       /* at this point the basis factorization and all basic solution
        * components are valid */
       xassert(lp->valid && csa->beta_st && csa->d_st);
@@ -907,6 +1001,35 @@ loop: /* main loop starts here */
          ret = GLP_EITLIM;
          goto fini;
       }
+      /* check if the search has been cancelled by the application */
+      if (csa->abort != NULL && *csa->abort)
+      {  if (csa->beta_st != 1)
+            csa->beta_st = 0;
+         if (csa->d_st != 1)
+            csa->d_st = 0;
+         if (!(csa->beta_st && csa->d_st))
+            goto loop;
+         display(csa, 1);
+         if (msg_lev >= GLP_MSG_ALL)
+            xprintf("SEARCH CANCELLED BY APPLICATION\n");
+         if (csa->phase == 1)
+         {  set_orig_bounds(csa);
+            check_flags(csa);
+            spx_eval_beta(lp, beta);
+         }
+         csa->num = spy_chuzr_sel(lp, beta, tol_bnd, tol_bnd1, list);
+         csa->p_stat = (csa->num == 0 ? GLP_FEAS : GLP_INFEAS);
+         csa->d_stat = (csa->phase == 1 ? GLP_INFEAS : GLP_FEAS);
+         ret = GLP_ECANCEL;
+         goto fini;
+      }
+      /* check if the search has to be suspended; all working components
+       * are valid at this point, so it can be continued later by
+       * calling this routine again */
+      if (csa->it_cnt != csa->it_run &&
+         ((csa->it_yld != 0 && csa->it_cnt >= csa->it_yld) ||
+          (csa->tm_yld != 0.0 && xtime() >= csa->tm_yld)))
+         return SPX_YIELD;
       /* display the search progress */
       display(csa, 0);
       /* select eligible basic variables */
@@ -1000,6 +1123,8 @@ loop: /* main loop starts here */
       /* update values of basic variables for adjacent basis */
       k = head[csa->p]; /* x[k] = xB[p] */
       p_flag = (l[k] != u[k] && beta[csa->p] > u[k]);
+      if (csa->nflip > 0)
+         flip_bounds(csa);
       spx_update_beta(lp, beta, csa->p, p_flag, csa->q, tcol);
       csa->beta_st = 2;
       /* update reduced costs of non-basic variables for adjacent
@@ -1014,11 +1139,11 @@ loop: /* main loop starts here */
       }
       /* update steepest edge weights for adjacent basis, if used */
       if (se != NULL)
-      {  if (refct > 0)
+      {  if (csa->refct > 0)
          {  if (spy_update_gamma(lp, se, csa->p, csa->q, trow, tcol)
                <= 1e-3)
             {  /* successful updating */
-               refct--;
+               csa->refct--;
             }
             else
             {  /* new weights are inaccurate; reset reference space */
@@ -1044,9 +1169,10 @@ loop: /* main loop starts here */
 fini: return ret;
 }
 
-int spy_dual(glp_prob *P, const glp_smcp *parm)
-{     /* driver to dual simplex method */
-      struct csa csa_, *csa = &csa_;
+struct wksp
+{     /* working objects of the dual simplex method, which are kept
+       * while the search is suspended */
+      struct csa csa;
       SPXLP lp;
 #if USE_AT
       SPXAT at;
@@ -1054,13 +1180,31 @@ int spy_dual(glp_prob *P, const glp_smcp *parm)
       SPXNT nt;
 #endif
       SPYSE se;
-      int ret, *map, *daeh;
+      glp_prob *P;
+      /* original problem object */
+      int *map;
+      /* map of original variables to working LP variables */
+      int ret;
+      /* code returned by the most recent run, SPX_YIELD if the search
+       * has not been finished yet */
+};
+
+void *spy_dual_start(glp_prob *P, const glp_smcp *parm)
+{     /* start dual simplex method; the search itself is performed by
+       * spy_dual_run */
+      struct wksp *wksp;
+      struct csa *csa;
+      int *map;
+      wksp = talloc(1, struct wksp);
+      memset(wksp, 0, sizeof(struct wksp));
+      wksp->P = P;
+      wksp->ret = SPX_YIELD;
       /* build working LP and its initial basis */
-      memset(csa, 0, sizeof(struct csa));
-      csa->lp = &lp;
+      csa = &wksp->csa;
+      csa->lp = &wksp->lp;
       spx_init_lp(csa->lp, P, EXCL);
       spx_alloc_lp(csa->lp);
-      map = talloc(1+P->m+P->n, int);
+      wksp->map = map = talloc(1+P->m+P->n, int);
       spx_build_lp(csa->lp, P, EXCL, SHIFT, map);
       spx_build_basis(csa->lp, P, map);
       switch (P->dir)
@@ -1081,15 +1225,19 @@ int spy_dual(glp_prob *P, const glp_smcp *parm)
       memcpy(csa->u, csa->lp->u, (1+csa->lp->n) * sizeof(double));
 #if USE_AT
       /* build matrix A in row-wise format */
-      csa->at = &at;
+      csa->at = &wksp->at;
       csa->nt = NULL;
       spx_alloc_at(csa->lp, csa->at);
+      if (parm->simd == GLP_OFF)
+         csa->at->simd = SPX_SIMD_OFF;
       spx_build_at(csa->lp, csa->at);
 #else
       /* build matrix N in row-wise format for initial basis */
       csa->at = NULL;
-      csa->nt = &nt;
+      csa->nt = &wksp->nt;
       spx_alloc_nt(csa->lp, csa->nt);
+      if (parm->simd == GLP_OFF)
+         csa->nt->simd = SPX_SIMD_OFF;
       spx_init_nt(csa->lp, csa->nt);
       spx_build_nt(csa->lp, csa->nt);
 #endif
@@ -1104,8 +1252,10 @@ int spy_dual(glp_prob *P, const glp_smcp *parm)
             csa->se = NULL;
             break;
          case GLP_PT_PSE:
-            csa->se = &se;
+            csa->se = &wksp->se;
             spy_alloc_se(csa->lp, csa->se);
+            if (parm->simd == GLP_OFF)
+               csa->se->simd = SPX_SIMD_OFF;
             break;
          default:
             xassert(parm != parm);
@@ -1113,6 +1263,13 @@ int spy_dual(glp_prob *P, const glp_smcp *parm)
       csa->list = talloc(1+csa->lp->m, int);
       csa->trow = talloc(1+csa->lp->n-csa->lp->m, double);
       csa->tcol = talloc(1+csa->lp->m, double);
+      if (parm->r_test == GLP_RT_FLIP)
+      {  csa->bp = talloc(1+csa->lp->n-csa->lp->m, SPYBP);
+         csa->flip = talloc(1+csa->lp->n-csa->lp->m, int);
+      }
+      else
+         csa->bp = NULL, csa->flip = NULL;
+      csa->nflip = 0;
       csa->work = talloc(1+csa->lp->m, double);
       csa->work1 = talloc(1+csa->lp->n-csa->lp->m, double);
       /* initialize control parameters */
@@ -1120,10 +1277,9 @@ int spy_dual(glp_prob *P, const glp_smcp *parm)
       csa->dualp = (parm->meth == GLP_DUALP);
       switch (parm->r_test)
       {  case GLP_RT_STD:
-            csa->harris = 0;
-            break;
          case GLP_RT_HAR:
-            csa->harris = 1;
+         case GLP_RT_FLIP:
+            csa->r_test = parm->r_test;
             break;
          default:
             xassert(parm != parm);
@@ -1145,6 +1301,7 @@ int spy_dual(glp_prob *P, const glp_smcp *parm)
       }
       csa->it_lim = parm->it_lim;
       csa->tm_lim = parm->tm_lim;
+      csa->abort = parm->abort;
       csa->out_frq = parm->out_frq;
       csa->out_dly = parm->out_dly;
       /* initialize working parameters */
@@ -1152,11 +1309,48 @@ int spy_dual(glp_prob *P, const glp_smcp *parm)
       csa->it_beg = csa->it_cnt = P->it_cnt;
       csa->it_dpy = -1;
       csa->inv_cnt = 0;
-      /* try to solve working LP */
-      ret = dual_simplex(csa);
+      return wksp;
+}
+
+int spy_dual_run(void *_wksp, int it_lim, double tm_lim, int *it_cnt)
+{     /* continue dual simplex method for at most it_lim iterations and
+       * tm_lim milliseconds (0 means no limit), at least one iteration
+       * is performed; the simplex iteration count is stored to it_cnt;
+       * returns SPX_YIELD if the search has been suspended, or the code
+       * to be returned by spy_dual */
+      struct wksp *wksp = _wksp;
+      struct csa *csa = &wksp->csa;
+      xassert(wksp->ret == SPX_YIELD);
+      csa->it_run = csa->it_cnt;
+      csa->it_yld = (it_lim == 0 ? 0 : csa->it_cnt + it_lim);
+      csa->tm_yld = (tm_lim == 0.0 ? 0.0 : xtime() + tm_lim);
+      wksp->ret = dual_simplex(csa);
+      *it_cnt = csa->it_cnt;
+      return wksp->ret >= 0 || wksp->ret == SPX_YIELD ? wksp->ret :
+         GLP_EFAIL;
+}
+
+int spy_dual_stop(void *_wksp)
+{     /* store results of dual simplex method to the problem object and
+       * free the workspace; if the search has not been finished, the
+       * problem object keeps its initial basis, the basic solution is
+       * undefined and GLP_ECANCEL is returned */
+      struct wksp *wksp = _wksp;
+      struct csa *csa = &wksp->csa;
+      glp_prob *P = wksp->P;
+      int ret = wksp->ret, *map = wksp->map, *daeh;
       /* return basis factorization back to problem object */
       P->valid = csa->lp->valid;
       P->bfd = csa->lp->bfd;
+      if (ret == SPX_YIELD)
+      {  /* the factorization does not correspond to the basis kept in
+          * the problem object */
+         P->valid = 0;
+         P->pbs_stat = P->dbs_stat = GLP_UNDEF;
+         P->it_cnt = csa->it_cnt;
+         ret = GLP_ECANCEL;
+         goto skip;
+      }
       /* set solution status */
       P->pbs_stat = csa->p_stat;
       P->dbs_stat = csa->d_stat;
@@ -1212,10 +1406,24 @@ skip: /* deallocate working objects and arrays */
       tfree(csa->list);
       tfree(csa->trow);
       tfree(csa->tcol);
+      if (csa->bp != NULL)
+         tfree(csa->bp);
+      if (csa->flip != NULL)
+         tfree(csa->flip);
       tfree(csa->work);
       tfree(csa->work1);
+      tfree(wksp);
       /* return to calling program */
       return ret >= 0 ? ret : GLP_EFAIL;
 }
 
+int spy_dual(glp_prob *P, const glp_smcp *parm)
+{     /* driver to dual simplex method */
+      void *wksp;
+      int it_cnt;
+      wksp = spy_dual_start(P, parm);
+      spy_dual_run(wksp, 0, 0.0, &it_cnt);
+      return spy_dual_stop(wksp);
+}
+
 /* eof */
@@ -147,7 +147,7 @@ namespace NodeGLPK {
             ReadModelWorker *worker = new ReadModelWorker(callback, mp, V8TOCSTRING(info[0]), info[1]->Int32Value());
             mp->thread = true;
             GLPKEnvStateDecorator* decorated = new GLPKEnvStateDecorator(worker, mp->emitter_, mp->env_state_);
-            Nan::AsyncQueueWorker(decorated);
+            QueueWorker(decorated);
         }
   
         GLP_BIND_VALUE_STR_INT32(Mathprog, ReadModelSync, glp_mpl_read_model);
@@ -191,7 +191,7 @@ namespace NodeGLPK {
             ReadDataWorker *worker = new ReadDataWorker(callback, mp, V8TOCSTRING(info[0]));
             mp->thread = true;
             GLPKEnvStateDecorator* decorated = new GLPKEnvStateDecorator(worker, mp->emitter_, mp->env_state_);
-            Nan::AsyncQueueWorker(decorated);
+            QueueWorker(decorated);
         }
         
         GLP_BIND_VALUE_STR(Mathprog, ReadDataSync, glp_mpl_read_data);
@@ -243,7 +243,7 @@ namespace NodeGLPK {
                 worker = new GenerateWorker(callback, mp, NULL);
             mp->thread = true;
             GLPKEnvStateDecorator* decorated = new GLPKEnvStateDecorator(worker, mp->emitter_, mp->env_state_);
-            Nan::AsyncQueueWorker(decorated);
+            QueueWorker(decorated);
         }
         
         static NAN_METHOD(GenerateSync) {
@@ -303,7 +303,7 @@ namespace NodeGLPK {
             mp->thread = true;
             lp->thread = true;
             GLPKEnvStateDecorator* decorated = new GLPKEnvStateDecorator(worker, mp->emitter_, mp->env_state_);
-            Nan::AsyncQueueWorker(decorated);
+            QueueWorker(decorated);
         }
         
         static NAN_METHOD(BuildProbSync){
@@ -365,7 +365,7 @@ namespace NodeGLPK {
             PostsolveWorker *worker = new PostsolveWorker(callback, mp, lp, info[1]->Int32Value());
             mp->thread = true;
             GLPKEnvStateDecorator* decorated = new GLPKEnvStateDecorator(worker, mp->emitter_, mp->env_state_);
-            Nan::AsyncQueueWorker(decorated);
+            QueueWorker(decorated);
         }
         
         static NAN_METHOD(PostsolveSync){
@@ -0,0 +1,193 @@
+#pragma once
+#ifndef _NODE_GLPK_MIPRACE_HPP
+#define _NODE_GLPK_MIPRACE_HPP
+
+#include <float.h>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "glpk/glpk.h"
+#include "parallelmip.hpp"
+
+namespace NodeGLPK {
+
+/// glp_intopt with several parameter sets at once, each run on its own copy of the problem in its
+/// own GLPK environment. The runs share their incumbents: every better integer solution a run finds
+/// is handed to the others through glp_ios_heur_sol at their next GLP_IHEUR. The first run to
+/// complete its search (0 or GLP_EMIPGAP) wins and the others are terminated.
+///
+/// The runs must agree on the column indices, so the MIP presolver is not used: as for ParallelMip,
+/// the LP relaxation is solved once beforehand when a parameter set asks for presolve.
+class MipRace {
+ public:
+    /// The parameter sets must not have a callback. `abort` stops every run when set to non-zero,
+    /// it may be NULL.
+    MipRace(glp_prob* P, const std::vector<glp_iocp>& configs, volatile int* abort)
+        : P_(P), configs_(configs), abort_(abort), sense_(glp_get_obj_dir(P) == GLP_MAX ? -1.0 : 1.0),
+          stop_(false), winner_(-1), best_(DBL_MAX), version_(0), runs_(configs.size()) {}
+
+    /// Returns as glp_intopt does, for the winner, or for the run with the best incumbent when
+    /// none completed; stores the solution of that run in P.
+    int Solve() {
+        bool presolve = false;
+        for (auto& parm : configs_) presolve |= parm.presolve == GLP_ON;
+        int ret = PrepareMip(P_, presolve);
+        if (ret != 0) return ret;
+
+        PrepareCopies(P_);
+        std::vector<std::thread> threads;
+        for (size_t k = 0; k < configs_.size(); k++) threads.emplace_back(&MipRace::Run, this, k);
+        for (auto& t : threads) t.join();
+
+        int chosen = winner_;
+        if (chosen < 0) {
+            double best = DBL_MAX;
+            chosen = 0;
+            for (size_t k = 0; k < runs_.size(); k++) {
+                const Outcome& run = runs_[k];
+                if ((run.status == GLP_FEAS || run.status == GLP_OPT) && run.value < best) {
+                    best = run.value;
+                    chosen = (int)k;
+                }
+            }
+        }
+        const Outcome& run = runs_[chosen];
+        glp_put_mip_sol(P_, run.status, run.x.data());
+        return run.ret;
+    }
+
+    /// The index of the winning parameter set, -1 when no run completed.
+    int Winner() const { return winner_; }
+
+    /// What glp_intopt returned for each parameter set.
+    std::vector<int> Rets() const {
+        std::vector<int> rets;
+        for (auto& run : runs_) rets.push_back(run.ret);
+        return rets;
+    }
+
+    /// How many solutions of the other runs each parameter set accepted.
+    std::vector<int> Injected() const {
+        std::vector<int> injected;
+        for (auto& run : runs_) injected.push_back(run.injected);
+        return injected;
+    }
+
+ private:
+    struct Outcome {
+        Outcome() : ret(GLP_EFAIL), status(GLP_UNDEF), value(DBL_MAX), injected(0) {}
+        int ret, status;
+        double value;   // minimization
+        std::vector<double> x;
+        int injected;
+    };
+
+    // the cb_info of a run
+    struct Hook {
+        MipRace* race;
+        size_t k;
+        uint64_t seen;          // the version of the shared incumbent last looked at
+        std::vector<double> x;
+    };
+
+    void Run(size_t k) {
+        glp_term_out(GLP_OFF);
+        HookErrors();
+        glp_prob* lp = glp_create_prob();
+
+        Hook hook;
+        hook.race = this;
+        hook.k = k;
+        hook.seen = 0;
+        glp_iocp parm = configs_[k];
+        parm.presolve = GLP_OFF;
+        parm.cb_func = Callback;
+        parm.cb_info = &hook;
+        parm.cb_reasons = GLP_FSELECT | GLP_FHEUR | GLP_FBINGO;
+
+        Outcome& run = runs_[k];
+        bool failed = false;
+        try {
+            glp_copy_prob(lp, P_, GLP_OFF);
+            run.ret = glp_intopt(lp, &parm);
+        } catch (std::string) {
+            run.ret = GLP_EFAIL;
+            failed = true;
+        }
+        run.status = failed ? GLP_UNDEF : glp_mip_status(lp);
+        int n = glp_get_num_cols(P_);
+        run.x.assign(n + 1, 0.0);
+        if (run.status == GLP_FEAS || run.status == GLP_OPT) {
+            run.value = sense_ * glp_mip_obj_val(lp);
+            for (int j = 1; j <= n; j++) run.x[j] = glp_mip_col_val(lp, j);
+        }
+        {
+            std::lock_guard<std::mutex> lock(lock_);
+            if ((run.ret == 0 || run.ret == GLP_EMIPGAP) && winner_ < 0) {
+                winner_ = (int)k;
+                stop_ = true;
+            }
+        }
+        // after an error glp_free_env releases lp
+        if (!failed) glp_delete_prob(lp);
+        glp_free_env();
+    }
+
+    static void Callback(glp_tree* T, void* info) {
+        Hook* hook = static_cast<Hook*>(info);
+        MipRace* race = hook->race;
+        if (race->stop_ || (race->abort_ && *race->abort_)) {
+            glp_ios_terminate(T);
+            return;
+        }
+        switch (glp_ios_reason(T)) {
+        case GLP_IBINGO:
+            race->Publish(T, hook);
+            break;
+        case GLP_IHEUR:
+            race->Inject(T, hook);
+            break;
+        }
+    }
+
+    void Publish(glp_tree* T, Hook* hook) {
+        glp_prob* mip = glp_ios_get_prob(T);
+        double value = sense_ * glp_mip_obj_val(mip);
+        std::lock_guard<std::mutex> lock(lock_);
+        if (value >= best_) return;
+        int n = glp_get_num_cols(mip);
+        x_.resize(n + 1);
+        for (int j = 1; j <= n; j++) x_[j] = glp_mip_col_val(mip, j);
+        best_ = value;
+        hook->seen = ++version_;
+    }
+
+    void Inject(glp_tree* T, Hook* hook) {
+        {
+            std::lock_guard<std::mutex> lock(lock_);
+            if (version_ == hook->seen) return;
+            hook->seen = version_;
+            hook->x = x_;
+        }
+        // rejected when not better than the incumbent of the run
+        if (glp_ios_heur_sol(T, hook->x.data()) == 0) runs_[hook->k].injected++;
+    }
+
+    glp_prob* P_;
+    std::vector<glp_iocp> configs_;
+    volatile int* abort_;
+    double sense_;
+    std::atomic<bool> stop_;
+    int winner_;
+    std::mutex lock_;
+    double best_;
+    std::vector<double> x_;
+    uint64_t version_;
+    std::vector<Outcome> runs_;
+};
+
+}  // namespace NodeGLPK
+#endif
@@ -69,12 +69,120 @@ extern "C" {
         info.GetReturnValue().Set(ret);
     }
 #endif
+
+    // solverPool({threads: n, affinity: [cpu, ...]}): runs the async methods on n dedicated threads
+    // instead of libuv's threadpool, threads: 0 goes back to libuv
+    NAN_METHOD(SolverPoolConfig) {
+        V8CHECK(info.Length() != 1, "Wrong number of arguments");
+        V8CHECK(!info[0]->IsObject(), "Wrong arguments");
+
+        Local<Object> obj = info[0]->ToObject();
+        Local<Value> threads = obj->Get(Nan::New<String>("threads").ToLocalChecked());
+        V8CHECK(!threads->IsInt32() || threads->Int32Value() < 0, "threads: should be a non-negative int32");
+        std::vector<int> affinity;
+        Local<Value> cpus = obj->Get(Nan::New<String>("affinity").ToLocalChecked());
+        if (!cpus->IsUndefined()) {
+            V8CHECK(!cpus->IsArray(), "affinity: should be an Array");
+            Local<Array> arr = Local<Array>::Cast(cpus);
+            for (uint32_t i = 0; i < arr->Length(); i++) {
+                Local<Value> cpu = arr->Get(i);
+                V8CHECK(!cpu->IsInt32() || cpu->Int32Value() < 0, "affinity: should contain cpu numbers");
+                affinity.push_back(cpu->Int32Value());
+            }
+        }
+
+        SolverPool& pool = SolverPool::Instance();
+        V8CHECK(pool.Busy(), "the solver pool is busy");
+        pool.Configure(threads->Int32Value(), affinity);
+    }
+
+    NAN_METHOD(SolverPoolStats) {
+        V8CHECK(info.Length() != 0, "Wrong number of arguments");
+
+        SolverPool::Stats stats = SolverPool::Instance().GetStats();
+        Local<v8::Object> ret = Nan::New<v8::Object>();
+        ret->Set(Nan::New<v8::String>("threads").ToLocalChecked(), Nan::New<v8::Number>(stats.threads));
+        ret->Set(Nan::New<v8::String>("queued").ToLocalChecked(), Nan::New<v8::Number>(stats.queued));
+        ret->Set(Nan::New<v8::String>("active").ToLocalChecked(), Nan::New<v8::Number>(stats.active));
+        ret->Set(Nan::New<v8::String>("submitted").ToLocalChecked(), Nan::New<v8::Number>(stats.submitted));
+        ret->Set(Nan::New<v8::String>("completed").ToLocalChecked(), Nan::New<v8::Number>(stats.completed));
+        ret->Set(Nan::New<v8::String>("busy").ToLocalChecked(), Nan::New<v8::Number>(stats.busy));
+        ret->Set(Nan::New<v8::String>("uptime").ToLocalChecked(), Nan::New<v8::Number>(stats.uptime));
+        double capacity = stats.threads * stats.uptime;
+        ret->Set(Nan::New<v8::String>("utilization").ToLocalChecked(), Nan::New<v8::Number>(capacity > 0 ? stats.busy / capacity : 0));
+
+        info.GetReturnValue().Set(ret);
+    }
+    
+    // mipScheduler({threads: n, sliceMs: t, sliceNodes: k}): sets up the threads which run
+    // scheduleIntopt; a slice ends after t milliseconds or k subproblem selections, whichever
+    // comes first (0 for no limit). Scheduled jobs keep their state.
+    NAN_METHOD(MipSchedulerConfig) {
+        V8CHECK(info.Length() != 1, "Wrong number of arguments");
+        V8CHECK(!info[0]->IsObject(), "Wrong arguments");
+
+        Local<Object> obj = info[0]->ToObject();
+        Local<Value> threads = obj->Get(Nan::New<String>("threads").ToLocalChecked());
+        V8CHECK(!threads->IsInt32() || threads->Int32Value() < 1, "threads: should be a positive int32");
+        double slice_ms = 50;
+        int slice_nodes = 0;
+        Local<Value> val = obj->Get(Nan::New<String>("sliceMs").ToLocalChecked());
+        if (!val->IsUndefined()) {
+            V8CHECK(!val->IsNumber() || val->NumberValue() < 0, "sliceMs: should be a non-negative number");
+            slice_ms = val->NumberValue();
+        }
+        val = obj->Get(Nan::New<String>("sliceNodes").ToLocalChecked());
+        if (!val->IsUndefined()) {
+            V8CHECK(!val->IsInt32() || val->Int32Value() < 0, "sliceNodes: should be a non-negative int32");
+            slice_nodes = val->Int32Value();
+        }
+        V8CHECK(slice_ms <= 0 && slice_nodes <= 0, "sliceMs or sliceNodes should be positive");
+
+        MipScheduler::Instance().Configure(threads->Int32Value(), slice_ms, slice_nodes);
+    }
+
+    NAN_METHOD(MipSchedulerStats) {
+        V8CHECK(info.Length() != 0, "Wrong number of arguments");
+
+        MipScheduler::Stats stats = MipScheduler::Instance().GetStats();
+        Local<v8::Object> ret = Nan::New<v8::Object>();
+        ret->Set(Nan::New<v8::String>("threads").ToLocalChecked(), Nan::New<v8::Number>(stats.threads));
+        ret->Set(Nan::New<v8::String>("ready").ToLocalChecked(), Nan::New<v8::Number>(stats.ready));
+        ret->Set(Nan::New<v8::String>("running").ToLocalChecked(), Nan::New<v8::Number>(stats.running));
+        ret->Set(Nan::New<v8::String>("paused").ToLocalChecked(), Nan::New<v8::Number>(stats.paused));
+        ret->Set(Nan::New<v8::String>("submitted").ToLocalChecked(), Nan::New<v8::Number>(stats.submitted));
+        ret->Set(Nan::New<v8::String>("completed").ToLocalChecked(), Nan::New<v8::Number>(stats.completed));
+        ret->Set(Nan::New<v8::String>("slices").ToLocalChecked(), Nan::New<v8::Number>(stats.slices));
+
+        info.GetReturnValue().Set(ret);
+    }
+    
+    // mipPlugins(): the native plug-ins available to the plugins option of intopt, as
+    // [{name, reasons}], reasons being the GLP_F* flags they are called for
+    NAN_METHOD(MipPluginList) {
+        V8CHECK(info.Length() != 0, "Wrong number of arguments");
+
+        Local<Array> ret = Nan::New<Array>();
+        uint32_t k = 0;
+        for (auto& p : MipPlugins::Instance().All()) {
+            Local<v8::Object> plugin = Nan::New<v8::Object>();
+            plugin->Set(Nan::New<v8::String>("name").ToLocalChecked(), Nan::New<v8::String>(p.first).ToLocalChecked());
+            plugin->Set(Nan::New<v8::String>("reasons").ToLocalChecked(), Nan::New<v8::Int32>(p.second.reasons));
+            ret->Set(k++, plugin);
+        }
+        info.GetReturnValue().Set(ret);
+    }
     
     void Init(Handle<Object> exports) {
         exports->Set(Nan::New<String>("termOutput").ToLocalChecked(), Nan::New<FunctionTemplate>(TermOutput)->GetFunction());
 #ifdef HAVE_ENV
         exports->Set(Nan::New<String>("glpMemInfo").ToLocalChecked(), Nan::New<FunctionTemplate>(glpMemInfo)->GetFunction());
 #endif
+        exports->Set(Nan::New<String>("solverPool").ToLocalChecked(), Nan::New<FunctionTemplate>(SolverPoolConfig)->GetFunction());
+        exports->Set(Nan::New<String>("solverPoolStats").ToLocalChecked(), Nan::New<FunctionTemplate>(SolverPoolStats)->GetFunction());
+        exports->Set(Nan::New<String>("mipScheduler").ToLocalChecked(), Nan::New<FunctionTemplate>(MipSchedulerConfig)->GetFunction());
+        exports->Set(Nan::New<String>("mipSchedulerStats").ToLocalChecked(), Nan::New<FunctionTemplate>(MipSchedulerStats)->GetFunction());
+        exports->Set(Nan::New<String>("mipPlugins").ToLocalChecked(), Nan::New<FunctionTemplate>(MipPluginList)->GetFunction());
         
         GLP_DEFINE_CONSTANT(exports, GLP_MAJOR_VERSION, MAJOR_VERSION);
         GLP_DEFINE_CONSTANT(exports, GLP_MINOR_VERSION, MINOR_VERSION);
@@ -127,12 +235,14 @@ extern "C" {
         GLP_DEFINE_CONSTANT(exports, GLP_PRIMAL, PRIMAL);
         GLP_DEFINE_CONSTANT(exports, GLP_DUALP, DUALP);
         GLP_DEFINE_CONSTANT(exports, GLP_DUAL, DUAL);
+        GLP_DEFINE_CONSTANT(exports, GLP_SIFTING, SIFTING);
         
         GLP_DEFINE_CONSTANT(exports, GLP_PT_STD, PT_STD);
         GLP_DEFINE_CONSTANT(exports, GLP_PT_PSE, PT_PSE);
         
         GLP_DEFINE_CONSTANT(exports, GLP_RT_STD, RT_STD);
         GLP_DEFINE_CONSTANT(exports, GLP_RT_HAR, RT_HAR);
+        GLP_DEFINE_CONSTANT(exports, GLP_RT_FLIP, RT_FLIP);
         
         GLP_DEFINE_CONSTANT(exports, GLP_ORD_NONE, ORD_NONE);
         GLP_DEFINE_CONSTANT(exports, GLP_ORD_QMD, ORD_QMD);
@@ -144,6 +254,7 @@ extern "C" {
         GLP_DEFINE_CONSTANT(exports, GLP_BR_MFV, BR_MFV);
         GLP_DEFINE_CONSTANT(exports, GLP_BR_DTH, BR_DTH);
         GLP_DEFINE_CONSTANT(exports, GLP_BR_PCH, BR_PCH);
+        GLP_DEFINE_CONSTANT(exports, GLP_BR_RLB, BR_RLB);
         
         GLP_DEFINE_CONSTANT(exports, GLP_BT_DFS, BT_DFS);
         GLP_DEFINE_CONSTANT(exports, GLP_BT_BFS, BT_BFS);
@@ -205,6 +316,7 @@ extern "C" {
         GLP_DEFINE_CONSTANT(exports, GLP_EINSTAB, EINSTAB);
         GLP_DEFINE_CONSTANT(exports, GLP_EDATA, EDATA);
         GLP_DEFINE_CONSTANT(exports, GLP_ERANGE, ERANGE);
+        GLP_DEFINE_CONSTANT(exports, GLP_ECANCEL, ECANCEL);
         
         GLP_DEFINE_CONSTANT(exports, GLP_KKT_PE, KKT_PE);
         GLP_DEFINE_CONSTANT(exports, GLP_KKT_PB, KKT_PB);
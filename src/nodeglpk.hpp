@@ -11,6 +11,7 @@
 
 #include "glpk/glpk.h"
 #include "glpk/env/glpenv.h"
+#include "solverpool.hpp"
 
 
 namespace NodeGLPK {
@@ -160,6 +161,24 @@ class GLPKEnvStateGuard {
 };
 
 
+/// Like GLPKEnvStateGuard, but the thread-local environment is kept for the next problem handled by
+/// the same thread; the thread calls glp_free_env() once it is done with all of them.
+class GLPKEnvStateLease {
+ public:
+    GLPKEnvStateLease(std::shared_ptr<glp_environ_state_t> state, std::shared_ptr<HookInfo> info) : env_state_(state) {
+        glp_env_tls_init_r(env_state_.get(), static_cast<void*>(info.get()));
+    }
+    ~GLPKEnvStateLease() noexcept {
+        struct glp_memory_counters counters1 = glp_counters_from_state(env_state_.get());
+        glp_env_tls_release_r(env_state_.get());
+        struct glp_memory_counters counters2 = glp_counters_from_state(env_state_.get());
+        _global_memory_statistics.updateCounters(counters1, counters2);
+    }
+ private:
+    std::shared_ptr<glp_environ_state_t> env_state_;
+};
+
+
 static inline std::shared_ptr<glp_environ_state_t> make_shared_environ_state(std::shared_ptr<HookInfo> info) {
     auto state = std::shared_ptr<glp_environ_state_t>(
         glp_init_env_state(static_cast<void*>(info.get()), TermHookManager::NodeHookCallback), glp_free_env_state);
@@ -0,0 +1,248 @@
+#pragma once
+#ifndef _NODE_GLPK_OPQUEUE_HPP
+#define _NODE_GLPK_OPQUEUE_HPP
+
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include <node.h>
+#include "glpk/glpk.h"
+#include "common.h"
+#include "descriptor.hpp"
+#include "parallelmip.hpp"
+
+namespace NodeGLPK {
+
+    using namespace v8;
+
+    /*
+     * One step of a Problem operation queue (see Problem::Enqueue). The arguments are copied
+     * when the operation is created on the main thread, Run() executes on the worker thread and
+     * Settle() hands the outcome to the promise back on the main thread.
+     */
+    class QueuedOp {
+    public:
+        QueuedOp() : resolve(NULL), reject(NULL) {}
+        virtual ~QueuedOp() {
+            delete resolve;
+            delete reject;
+        }
+
+        // returns an error message, empty on success; must not abort on bad input
+        virtual std::string Run(glp_prob* P) = 0;
+        virtual Local<Value> Result() { return Nan::Undefined(); }
+
+        // the executor runs synchronously and keeps resolve/reject as callbacks, so that settling
+        // goes through MakeCallback and the promise reactions run right away
+        Local<Value> NewPromise() {
+            Local<Object> global = Nan::GetCurrentContext()->Global();
+            Local<Function> promise = Local<Function>::Cast(global->Get(Nan::New<String>("Promise").ToLocalChecked()));
+            Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(Executor, Nan::New<External>(this));
+            Local<Value> argv[] = {tpl->GetFunction()};
+            return Nan::NewInstance(promise, 1, argv).ToLocalChecked();
+        }
+
+        void Settle() {
+            if (error.empty()) {
+                Local<Value> argv[] = {Result()};
+                resolve->Call(1, argv);
+            } else {
+                Local<Value> argv[] = {Nan::Error(error.c_str())};
+                reject->Call(1, argv);
+            }
+        }
+
+        std::string error;
+
+    protected:
+        static std::string OutOfRange(const char* what, int k) {
+            return std::string(what) + " " + std::to_string(k) + ": Index out of range";
+        }
+
+    private:
+        static NAN_METHOD(Executor) {
+            QueuedOp* op = static_cast<QueuedOp*>(info.Data().As<External>()->Value());
+            op->resolve = new Nan::Callback(info[0].As<Function>());
+            op->reject = new Nan::Callback(info[1].As<Function>());
+        }
+
+        Nan::Callback *resolve, *reject;
+    };
+
+    class QueuedObjDir : public QueuedOp {
+    public:
+        explicit QueuedObjDir(int dir) : dir(dir) {}
+        std::string Run(glp_prob* P) {
+            if (dir != GLP_MIN && dir != GLP_MAX) return "Invalid direction";
+            glp_set_obj_dir(P, dir);
+            return std::string();
+        }
+        int dir;
+    };
+
+    class QueuedBnds : public QueuedOp {
+    public:
+        QueuedBnds(bool row, int k, int type, double lb, double ub) : row(row), k(k), type(type), lb(lb), ub(ub) {}
+        std::string Run(glp_prob* P) {
+            if (k < 1 || k > (row ? glp_get_num_rows(P) : glp_get_num_cols(P)))
+                return OutOfRange(row ? "row" : "column", k);
+            if (type < GLP_FR || type > GLP_FX) return "Invalid type";
+            if (row)
+                glp_set_row_bnds(P, k, type, lb, ub);
+            else
+                glp_set_col_bnds(P, k, type, lb, ub);
+            return std::string();
+        }
+        bool row;
+        int k, type;
+        double lb, ub;
+    };
+
+    class QueuedObjCoef : public QueuedOp {
+    public:
+        QueuedObjCoef(int j, double coef) : j(j), coef(coef) {}
+        std::string Run(glp_prob* P) {
+            if (j < 0 || j > glp_get_num_cols(P)) return OutOfRange("column", j);
+            glp_set_obj_coef(P, j, coef);
+            return std::string();
+        }
+        int j;
+        double coef;
+    };
+
+    class QueuedColKind : public QueuedOp {
+    public:
+        QueuedColKind(int j, int kind) : j(j), kind(kind) {}
+        std::string Run(glp_prob* P) {
+            if (j < 1 || j > glp_get_num_cols(P)) return OutOfRange("column", j);
+            if (kind < GLP_CV || kind > GLP_BV) return "Invalid kind";
+            glp_set_col_kind(P, j, kind);
+            return std::string();
+        }
+        int j, kind;
+    };
+
+    class QueuedMat : public QueuedOp {
+    public:
+        QueuedMat(bool row, int k, const int* ind, const double* val, int len)
+            : row(row), k(k), ind(ind, ind + len + 1), val(val, val + len + 1) {}
+        std::string Run(glp_prob* P) {
+            int m = glp_get_num_rows(P), n = glp_get_num_cols(P);
+            if (k < 1 || k > (row ? m : n)) return OutOfRange(row ? "row" : "column", k);
+            int len = (int)ind.size() - 1;
+            std::vector<char> seen((row ? n : m) + 1, 0);
+            for (int p = 1; p <= len; p++) {
+                if (ind[p] < 1 || ind[p] > (row ? n : m)) return OutOfRange(row ? "column" : "row", ind[p]);
+                if (seen[ind[p]]) return "duplicate indices not allowed";
+                seen[ind[p]] = 1;
+            }
+            if (row)
+                glp_set_mat_row(P, k, len, ind.data(), val.data());
+            else
+                glp_set_mat_col(P, k, len, ind.data(), val.data());
+            return std::string();
+        }
+        bool row;
+        int k;
+        std::vector<int> ind;
+        std::vector<double> val;
+    };
+
+    class QueuedLoadMatrix : public QueuedOp {
+    public:
+        QueuedLoadMatrix(int ne, const int* ia, const int* ja, const double* ar)
+            : ia(ia, ia + ne + 1), ja(ja, ja + ne + 1), ar(ar, ar + ne + 1) {}
+        std::string Run(glp_prob* P) {
+            ProblemDescriptor desc;
+            desc.rows = glp_get_num_rows(P);
+            desc.cols = glp_get_num_cols(P);
+            desc.format = ProblemDescriptor::COO;
+            desc.ne = (int)ia.size() - 1;
+            desc.ia = ia.data();
+            desc.ja = ja.data();
+            desc.value = ar.data();
+            std::string error = desc.Validate();
+            if (error.empty()) glp_load_matrix(P, desc.ne, desc.ia, desc.ja, desc.value);
+            return error;
+        }
+        std::vector<int> ia, ja;
+        std::vector<double> ar;
+    };
+
+    class QueuedSimplex : public QueuedOp {
+    public:
+        explicit QueuedSimplex(bool exact) : exact(exact), ret(0) { glp_init_smcp(&smcp); }
+        std::string Run(glp_prob* P) {
+            ret = exact ? glp_exact(P, &smcp) : glp_simplex(P, &smcp);
+            return std::string();
+        }
+        Local<Value> Result() { return Nan::New<Int32>(ret); }
+        bool exact;
+        int ret;
+        glp_smcp smcp;
+    };
+
+    class QueuedInterior : public QueuedOp {
+    public:
+        QueuedInterior() : ret(0) { glp_init_iptcp(&iptcp); }
+        std::string Run(glp_prob* P) {
+            ret = glp_interior(P, &iptcp);
+            return std::string();
+        }
+        Local<Value> Result() { return Nan::New<Int32>(ret); }
+        int ret;
+        glp_iptcp iptcp;
+    };
+
+    class QueuedIntopt : public QueuedOp {
+    public:
+        QueuedIntopt() : ret(0) { glp_init_iocp(&iocp); }
+        ~QueuedIntopt() {
+            if (iocp.save_sol) delete[] iocp.save_sol;
+        }
+        std::string Run(glp_prob* P) {
+            ret = RunIntopt(P, &iocp);
+            return std::string();
+        }
+        Local<Value> Result() { return Nan::New<Int32>(ret); }
+        int ret;
+        glp_iocp iocp;
+    };
+
+    template <typename T>
+    class QueuedValue : public QueuedOp {
+    public:
+        explicit QueuedValue(T (*api)(glp_prob*)) : api(api), value(0) {}
+        std::string Run(glp_prob* P) {
+            value = api(P);
+            return std::string();
+        }
+        Local<Value> Result() { return Nan::New<Number>(value); }
+        T (*api)(glp_prob*);
+        T value;
+    };
+
+    class QueuedArray : public QueuedOp {
+    public:
+        QueuedArray(bool rows, double (*api)(glp_prob*, int)) : rows(rows), api(api) {}
+        std::string Run(glp_prob* P) {
+            int count = rows ? glp_get_num_rows(P) : glp_get_num_cols(P);
+            values.assign(count + 1, 0.0);
+            for (int k = 1; k <= count; k++) values[k] = api(P, k);
+            return std::string();
+        }
+        Local<Value> Result() {
+            size_t count = values.size();
+            Local<Float64Array> ret = Float64Array::New(ArrayBuffer::New(Isolate::GetCurrent(), sizeof(double) * count), 0, count);
+            Nan::TypedArrayContents<double> dst(ret);
+            if (count) memcpy(*dst, values.data(), sizeof(double) * count);
+            return ret;
+        }
+        bool rows;
+        double (*api)(glp_prob*, int);
+        std::vector<double> values;
+    };
+}
+
+#endif
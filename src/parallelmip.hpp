@@ -0,0 +1,542 @@
+#pragma once
+#ifndef _NODE_GLPK_PARALLELMIP_HPP
+#define _NODE_GLPK_PARALLELMIP_HPP
+
+#include <float.h>
+#include <limits.h>
+#include <math.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "glpk/glpk.h"
+extern "C" {
+#include "glpk/misc/rng.h"
+}
+
+namespace NodeGLPK {
+
+/// Checks P as glp_intopt does before a search on copies of it, which cannot use the MIP presolver:
+/// with `presolve`, the LP relaxation is solved first when P has no optimal basis. Returns 0 when
+/// the search can start from the optimal basis of P, else as glp_intopt.
+static inline int PrepareMip(glp_prob* P, bool presolve) {
+    int n = glp_get_num_cols(P);
+    for (int j = 1; j <= n; j++) {
+        if (glp_get_col_kind(P, j) == GLP_CV) continue;
+        int type = glp_get_col_type(P, j);
+        double lb = glp_get_col_lb(P, j), ub = glp_get_col_ub(P, j);
+        if ((type == GLP_LO || type == GLP_DB || type == GLP_FX) && lb != floor(lb)) return GLP_EBOUND;
+        if ((type == GLP_UP || type == GLP_DB) && ub != floor(ub)) return GLP_EBOUND;
+    }
+    if (glp_get_status(P) != GLP_OPT && presolve) {
+        glp_smcp smcp;
+        glp_init_smcp(&smcp);
+        smcp.msg_lev = GLP_MSG_OFF;
+        smcp.presolve = GLP_ON;
+        glp_simplex(P, &smcp);
+        if (glp_get_status(P) == GLP_NOFEAS || glp_get_prim_stat(P) == GLP_NOFEAS) {
+            glp_put_mip_sol(P, GLP_NOFEAS, NULL);
+            return GLP_ENOPFS;
+        }
+        if (glp_get_status(P) == GLP_UNBND) {
+            glp_put_mip_sol(P, GLP_UNDEF, NULL);
+            return GLP_ENODFS;
+        }
+    }
+    if (glp_get_status(P) != GLP_OPT) return GLP_EROOT;
+    return 0;
+}
+
+/// Prepares P to be copied by glp_copy_prob from several threads at once. glp_copy_prob reads the
+/// factorization parameters, which creates the driver of the source on first use: do it here so
+/// that the copies only read the problem.
+static inline void PrepareCopies(glp_prob* P) {
+    glp_bfcp bfcp;
+    glp_get_bfcp(P, &bfcp);
+}
+
+void _ErrorHook(void* s);
+
+/// Makes an error of GLPK on the calling thread throw a std::string instead of aborting the
+/// process; the environment of a new thread has no error hook. After the error only glp_free_env
+/// may be called, it releases the problems of the thread as well.
+static inline void HookErrors() {
+    glp_error_hook(_ErrorHook, const_cast<char*>("GLPK error on a worker thread"));
+}
+
+/// Branch-and-bound on glp_iocp.threads threads. Every thread solves the LP relaxations of its
+/// subproblems on its own copy of the problem, in its own GLPK environment. A subproblem is kept
+/// as what ios_freeze_node keeps of a node: the column bounds changed since the root and the basis
+/// of its parent; the thread picking it up revives it on its copy. Threads dive depth-first into
+/// their own subproblems and, once out of work, steal the shallowest open ones of the others. The
+/// incumbent is shared, every thread prunes against it.
+///
+/// The search starts from an optimal basis of the LP relaxation, like glp_intopt without presolve
+/// (with presolve the relaxation is solved first when needed). There are no cuts, heuristics or
+/// node preprocessing; br_tech FFV, LFV and MFV are honoured, the others branch on the most
+/// fractional variable, and bt_tech is not used.
+///
+/// With par_det on, the search is deterministic: it goes in rounds of up to 4 * threads open
+/// nodes, spread over the threads by position, and the outcomes are merged in that order between
+/// rounds. The same problem, parameters and thread count always explore the same tree, at the
+/// cost of waiting for the slowest node of each round. Ties of the MFV rule are then broken with
+/// the random generator of the thread, seeded with par_seed + its index.
+class ParallelMip {
+ public:
+    struct Stats {
+        uint64_t nodes, steals;
+    };
+
+    /// `abort` stops the search with GLP_ESTOP when set to non-zero, it may be NULL.
+    ParallelMip(glp_prob* P, const glp_iocp* parm, volatile int* abort)
+        : P_(P), parm_(parm), abort_(abort), threads_(parm->threads < 1 ? 1 : parm->threads),
+          n_(glp_get_num_cols(P)), sense_(glp_get_obj_dir(P) == GLP_MAX ? -1.0 : 1.0),
+          open_(0), stop_(false), ret_(0), gap_pruned_(false), best_(DBL_MAX), nodes_(0), steals_(0),
+          generation_(0), done_(0), finished_(false) {}
+
+    /// Returns as glp_intopt does and stores the best integer solution found in P.
+    int Solve() {
+        int ret = Prepare();
+        if (ret != 0) return ret;
+
+        glp_smcp smcp;
+        glp_init_smcp(&smcp);
+        smcp.msg_lev = GLP_MSG_OFF;
+        smcp.meth = GLP_DUALP;
+        smcp.abort = abort_;
+
+        Node root;
+        root.basis = Snapshot(P_);
+        root.bound = sense_ * glp_get_obj_val(P_);
+        for (size_t k = 0; k < threads_; k++) workers_.emplace_back(new Worker());
+        Push(0, std::move(root));
+
+        PrepareCopies(P_);
+        start_ = std::chrono::steady_clock::now();
+        if (parm_->par_det == GLP_ON) {
+            RunRounds(smcp);
+        } else {
+            std::vector<std::thread> threads;
+            for (size_t k = 0; k < threads_; k++) threads.emplace_back(&ParallelMip::Run, this, k, smcp);
+            for (auto& t : threads) t.join();
+        }
+
+        bool found = best_.load() != DBL_MAX;
+        if (ret_ != 0) {
+            glp_put_mip_sol(P_, found ? GLP_FEAS : GLP_UNDEF, x_.data());
+            return ret_;
+        }
+        if (gap_pruned_) {
+            glp_put_mip_sol(P_, GLP_FEAS, x_.data());
+            return GLP_EMIPGAP;
+        }
+        glp_put_mip_sol(P_, found ? GLP_OPT : GLP_NOFEAS, x_.data());
+        return 0;
+    }
+
+    Stats GetStats() const { return Stats{nodes_.load(), steals_.load()}; }
+
+ private:
+    struct Bound {
+        int j;
+        double lb, ub;  // -DBL_MAX, +DBL_MAX for none
+    };
+
+    struct Basis {
+        std::vector<char> row, col;
+    };
+
+    struct Node {
+        std::vector<Bound> bounds;  // in branching order, the last one of a column holds
+        std::shared_ptr<const Basis> basis;
+        double bound;               // of the parent, minimization
+    };
+
+    struct Worker {
+        std::mutex lock;
+        std::deque<Node> nodes;
+    };
+
+    // what a thread keeps between nodes
+    struct Context {
+        glp_prob* lp;
+        glp_smcp smcp;
+        std::vector<double> lb, ub;          // of the root
+        std::vector<int> touched;            // columns whose bounds differ from the root
+        std::shared_ptr<const Basis> current; // the basis left in lp by the last node
+        RNG rng;
+        bool failed;                         // GLPK has failed on lp, which is left to glp_free_env
+    };
+
+    // what a node gives back
+    struct Outcome {
+        int ret;                    // non-zero when the search has to stop
+        bool integral;              // the LP solution is a new integer point
+        double value;               // minimization
+        std::vector<double> x;
+        std::vector<Node> children; // the one to take next is last
+    };
+
+    static const size_t kRoundNodes = 4;
+
+    int Prepare() {
+        x_.assign(n_ + 1, 0.0);
+        return PrepareMip(P_, parm_->presolve == GLP_ON);
+    }
+
+    static std::shared_ptr<const Basis> Snapshot(glp_prob* lp) {
+        std::shared_ptr<Basis> basis = std::make_shared<Basis>();
+        int m = glp_get_num_rows(lp), n = glp_get_num_cols(lp);
+        basis->row.resize(m + 1);
+        basis->col.resize(n + 1);
+        for (int i = 1; i <= m; i++) basis->row[i] = (char)glp_get_row_stat(lp, i);
+        for (int j = 1; j <= n; j++) basis->col[j] = (char)glp_get_col_stat(lp, j);
+        return basis;
+    }
+
+    static void SetBounds(glp_prob* lp, int j, double lb, double ub) {
+        int type;
+        if (lb == -DBL_MAX)
+            type = ub == DBL_MAX ? GLP_FR : GLP_UP;
+        else if (ub == DBL_MAX)
+            type = GLP_LO;
+        else
+            type = lb == ub ? GLP_FX : GLP_DB;
+        glp_set_col_bnds(lp, j, type, lb, ub);
+    }
+
+    void Push(size_t k, Node&& node) {
+        open_++;
+        {
+            std::lock_guard<std::mutex> lock(workers_[k]->lock);
+            workers_[k]->nodes.push_back(std::move(node));
+        }
+        idle_.notify_one();
+    }
+
+    // the deepest node of thread k, else the shallowest of another thread
+    bool Take(size_t k, Node& node) {
+        {
+            std::lock_guard<std::mutex> lock(workers_[k]->lock);
+            if (!workers_[k]->nodes.empty()) {
+                node = std::move(workers_[k]->nodes.back());
+                workers_[k]->nodes.pop_back();
+                return true;
+            }
+        }
+        for (size_t d = 1; d < threads_; d++) {
+            Worker* victim = workers_[(k + d) % threads_].get();
+            std::lock_guard<std::mutex> lock(victim->lock);
+            if (!victim->nodes.empty()) {
+                node = std::move(victim->nodes.front());
+                victim->nodes.pop_front();
+                steals_++;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Stop(int ret) {
+        std::lock_guard<std::mutex> lock(idle_lock_);
+        if (!stop_) {
+            ret_ = ret;
+            stop_ = true;
+        }
+        idle_.notify_all();
+    }
+
+    // a node bound which may still improve the incumbent, by more than tol_obj and the MIP gap
+    bool Hopeful(double bound) {
+        double best = best_.load();
+        if (best == DBL_MAX) return true;
+        double eps = parm_->tol_obj * (1.0 + fabs(best));
+        if (bound < best - eps) {
+            if (parm_->mip_gap <= 0.0 || bound < best - parm_->mip_gap * (fabs(best) + DBL_EPSILON)) return true;
+            gap_pruned_ = true;
+        }
+        return false;
+    }
+
+    void Incumbent(double value, const std::vector<double>& x) {
+        std::lock_guard<std::mutex> lock(incumbent_lock_);
+        if (value >= best_.load()) return;
+        x_ = x;
+        best_ = value;
+    }
+
+    int RemainingMs() const {
+        if (parm_->tm_lim == INT_MAX) return INT_MAX;
+        auto spent = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_);
+        return parm_->tm_lim - (int)spent.count();
+    }
+
+    // checked between nodes, or rounds
+    bool Interrupted() {
+        if (abort_ && *abort_) {
+            Stop(GLP_ESTOP);
+            return true;
+        }
+        if (RemainingMs() <= 0) {
+            Stop(GLP_ETMLIM);
+            return true;
+        }
+        return stop_;
+    }
+
+    void Open(Context& c, size_t k) {
+        glp_term_out(GLP_OFF);
+        HookErrors();
+        c.failed = false;
+        c.lp = glp_create_prob();
+        c.lb.resize(n_ + 1);
+        c.ub.resize(n_ + 1);
+        try {
+            glp_copy_prob(c.lp, P_, GLP_OFF);
+            for (int j = 1; j <= n_; j++) {
+                c.lb[j] = glp_get_col_lb(c.lp, j);
+                c.ub[j] = glp_get_col_ub(c.lp, j);
+            }
+        } catch (std::string) {
+            c.failed = true;
+        }
+        rng_init_rand(&c.rng, parm_->par_seed + (int)k);
+    }
+
+    void Close(Context& c) {
+        if (!c.failed) glp_delete_prob(c.lp);
+        glp_free_env();
+    }
+
+    void Run(size_t k, glp_smcp smcp) {
+        Context c;
+        c.smcp = smcp;
+        Open(c, k);
+        for (;;) {
+            if (Interrupted()) break;
+            Node node;
+            if (!Take(k, node)) {
+                if (open_ == 0) break;
+                std::unique_lock<std::mutex> lock(idle_lock_);
+                idle_.wait_for(lock, std::chrono::milliseconds(1));
+                continue;
+            }
+            if (Hopeful(node.bound)) {
+                Outcome out;
+                Process(c, node, out);
+                if (out.ret) Stop(out.ret);
+                if (out.integral) Incumbent(out.value, out.x);
+                for (auto& child : out.children) Push(k, std::move(child));
+            }
+            nodes_++;
+            if (--open_ == 0) idle_.notify_all();
+        }
+        Close(c);
+    }
+
+    // deterministic search: the calling thread hands out rounds of nodes, thread k takes the ones
+    // at k, k + threads, ... and the outcomes are merged in node order once all are done, so the
+    // nodes, incumbents and per-thread random draws do not depend on timing
+    void RunRounds(const glp_smcp& smcp) {
+        std::vector<std::thread> threads;
+        for (size_t k = 0; k < threads_; k++) threads.emplace_back(&ParallelMip::RunRound, this, k, smcp);
+        std::vector<Node> stack;
+        {
+            std::lock_guard<std::mutex> lock(workers_[0]->lock);
+            for (auto& node : workers_[0]->nodes) stack.push_back(std::move(node));
+            workers_[0]->nodes.clear();
+        }
+        while (!stack.empty() && !Interrupted()) {
+            std::unique_lock<std::mutex> lock(round_lock_);
+            round_.clear();
+            while (!stack.empty() && round_.size() < threads_ * kRoundNodes) {
+                if (Hopeful(stack.back().bound)) round_.push_back(std::move(stack.back()));
+                stack.pop_back();
+                nodes_++;
+            }
+            outcomes_.assign(round_.size(), Outcome());
+            done_ = 0;
+            generation_++;
+            round_cond_.notify_all();
+            round_cond_.wait(lock, [this] { return done_ == threads_; });
+            for (auto& out : outcomes_) {
+                if (out.ret) Stop(out.ret);
+                if (out.integral) Incumbent(out.value, out.x);
+                for (auto& child : out.children) stack.push_back(std::move(child));
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(round_lock_);
+            finished_ = true;
+        }
+        round_cond_.notify_all();
+        for (auto& t : threads) t.join();
+    }
+
+    void RunRound(size_t k, glp_smcp smcp) {
+        Context c;
+        c.smcp = smcp;
+        Open(c, k);
+        uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(round_lock_);
+                round_cond_.wait(lock, [this, seen] { return finished_ || generation_ != seen; });
+                if (finished_) break;
+                seen = generation_;
+            }
+            for (size_t i = k; i < round_.size(); i += threads_) Process(c, round_[i], outcomes_[i]);
+            std::lock_guard<std::mutex> lock(round_lock_);
+            if (++done_ == threads_) round_cond_.notify_all();
+        }
+        Close(c);
+    }
+
+    // revives the node on the copy of the thread, solves its LP relaxation and branches
+    void Process(Context& c, const Node& node, Outcome& out) {
+        glp_prob* lp = c.lp;
+        out.ret = 0;
+        out.integral = false;
+        if (c.failed) {
+            out.ret = GLP_EFAIL;
+            return;
+        }
+        try {
+            for (int j : c.touched) SetBounds(lp, j, c.lb[j], c.ub[j]);
+            c.touched.clear();
+            for (auto& b : node.bounds) {
+                SetBounds(lp, b.j, b.lb, b.ub);
+                c.touched.push_back(b.j);
+            }
+            // the basis is still there when diving; the deterministic search always starts
+            // from a fresh factorization, an updated one may pivot differently
+            if (node.basis != c.current) {
+                for (int i = 1; i < (int)node.basis->row.size(); i++) glp_set_row_stat(lp, i, node.basis->row[i]);
+                for (int j = 1; j <= n_; j++) glp_set_col_stat(lp, j, node.basis->col[j]);
+            }
+            if (parm_->par_det == GLP_ON && glp_bf_exists(lp)) glp_factorize(lp);
+            c.current = nullptr;
+
+            // the time limit may have run out since the last check, and glp_simplex refuses a
+            // negative one
+            c.smcp.tm_lim = RemainingMs();
+            if (c.smcp.tm_lim <= 0) {
+                out.ret = GLP_ETMLIM;
+                return;
+            }
+            int ret = glp_simplex(lp, &c.smcp);
+            if (ret != 0 && ret != GLP_ESTOP && ret != GLP_ETMLIM) {
+                // the parent's basis may be singular in the child, start over from a fresh one
+                glp_std_basis(lp);
+                ret = glp_simplex(lp, &c.smcp);
+            }
+            if (ret != 0) {
+                out.ret = ret == GLP_ETMLIM || ret == GLP_ESTOP ? ret : GLP_EFAIL;
+                return;
+            }
+        } catch (std::string) {
+            c.failed = true;
+            out.ret = GLP_EFAIL;
+            return;
+        }
+        int status = glp_get_status(lp);
+        if (status == GLP_NOFEAS) return;
+        if (status != GLP_OPT) {
+            out.ret = GLP_EFAIL;
+            return;
+        }
+        double bound = sense_ * glp_get_obj_val(lp);
+        if (!Hopeful(bound)) return;
+
+        // ties of the most fractional rule are broken at random
+        int branch = 0, ties = 0;
+        double score = -1.0, value = 0.0;
+        for (int j = 1; j <= n_; j++) {
+            if (glp_get_col_kind(lp, j) == GLP_CV) continue;
+            double x = glp_get_col_prim(lp, j);
+            double f = x - floor(x);
+            if (f <= parm_->tol_int || f >= 1.0 - parm_->tol_int) continue;
+            double s = f < 0.5 ? f : 1.0 - f;
+            if (parm_->br_tech == GLP_BR_FFV) {
+                branch = j;
+                value = x;
+                break;
+            }
+            if (parm_->br_tech == GLP_BR_LFV || s > score + 1e-12) {
+                branch = j;
+                value = x;
+                score = s;
+                ties = 1;
+            } else if (s >= score - 1e-12 && rng_unif_rand(&c.rng, ++ties) == 0) {
+                branch = j;
+                value = x;
+            }
+        }
+        if (!branch) {
+            out.integral = true;
+            out.value = bound;
+            out.x.resize(n_ + 1);
+            for (int j = 1; j <= n_; j++) {
+                double x = glp_get_col_prim(lp, j);
+                out.x[j] = glp_get_col_kind(lp, j) == GLP_CV ? x : floor(x + 0.5);
+            }
+            return;
+        }
+
+        std::shared_ptr<const Basis> basis = Snapshot(lp);
+        double lb = glp_get_col_lb(lp, branch), ub = glp_get_col_ub(lp, branch);
+        Node down, up;
+        down.bounds = node.bounds;
+        down.bounds.push_back(Bound{branch, lb, floor(value)});
+        up.bounds = node.bounds;
+        up.bounds.push_back(Bound{branch, ceil(value), ub});
+        down.basis = up.basis = basis;
+        down.bound = up.bound = bound;
+        // the child towards the nearest integer is taken next
+        bool up_first = value - floor(value) > 0.5;
+        out.children.push_back(std::move(up_first ? down : up));
+        out.children.push_back(std::move(up_first ? up : down));
+        c.current = basis;
+    }
+
+    glp_prob* P_;
+    const glp_iocp* parm_;
+    volatile int* abort_;
+    size_t threads_;
+    int n_;
+    double sense_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<int64_t> open_;
+    std::mutex idle_lock_;
+    std::condition_variable idle_;
+    std::atomic<bool> stop_;
+    int ret_;
+    std::atomic<bool> gap_pruned_;
+    std::mutex incumbent_lock_;
+    std::atomic<double> best_;
+    std::vector<double> x_;
+    std::atomic<uint64_t> nodes_, steals_;
+    // deterministic rounds
+    std::mutex round_lock_;
+    std::condition_variable round_cond_;
+    std::vector<Node> round_;
+    std::vector<Outcome> outcomes_;
+    uint64_t generation_;
+    size_t done_;
+    bool finished_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+/// glp_intopt, on several threads when parm->threads > 1.
+static inline int RunIntopt(glp_prob* P, const glp_iocp* parm, volatile int* abort = NULL) {
+    if (parm->threads > 1) return ParallelMip(P, parm, abort).Solve();
+    return glp_intopt(P, parm);
+}
+
+}  // namespace NodeGLPK
+#endif
@@ -0,0 +1,152 @@
+#pragma once
+#ifndef _NODE_GLPK_PLUGINS_HPP
+#define _NODE_GLPK_PLUGINS_HPP
+
+#include <math.h>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "glpk/glpk.h"
+
+namespace NodeGLPK {
+
+/// A branch-and-bound customisation in native code: a branching rule, a primal heuristic, a
+/// node selection rule or a cut separator. `callback` is called on the thread running the
+/// search, for the reasons in `reasons` (GLP_F* flags), with the state made by `create`; it
+/// must not use V8. Plug-ins are selected by name with the `plugins` option of intopt.
+struct MipPlugin {
+    std::string name;
+    int reasons;
+    void (*callback)(glp_tree* T, void* state);
+    void* (*create)();            // may be NULL, the state is then NULL
+    void (*destroy)(void* state); // may be NULL
+};
+
+/// The plug-ins compiled into the module. Further ones are added with Add() before the first
+/// intopt using them, e.g. from Init() in nodeglpk.cc.
+class MipPlugins {
+ public:
+    static MipPlugins& Instance() {
+        static MipPlugins plugins;
+        return plugins;
+    }
+
+    /// Main thread only. Returns false when the name is taken.
+    bool Add(const MipPlugin& plugin) {
+        return plugins_.insert(std::make_pair(plugin.name, plugin)).second;
+    }
+
+    const MipPlugin* Find(const std::string& name) const {
+        auto it = plugins_.find(name);
+        return it == plugins_.end() ? NULL : &it->second;
+    }
+
+    const std::map<std::string, MipPlugin>& All() const { return plugins_; }
+
+ private:
+    MipPlugins();
+    std::map<std::string, MipPlugin> plugins_;
+};
+
+/// The plug-ins of one search, each with its own state, in the order they were asked for.
+class MipPluginChain {
+ public:
+    MipPluginChain() : reasons_(0) {}
+    ~MipPluginChain() {
+        for (auto& p : chain_) {
+            if (p.first->destroy) p.first->destroy(p.second);
+        }
+    }
+
+    void Add(const MipPlugin* plugin) {
+        chain_.push_back(std::make_pair(plugin, plugin->create ? plugin->create() : NULL));
+        reasons_ |= plugin->reasons;
+    }
+
+    int Reasons() const { return reasons_; }
+
+    /// Calls the plug-ins handling the current reason of T.
+    void Run(glp_tree* T) {
+        int reason = 1 << glp_ios_reason(T);
+        if (!(reason & reasons_)) return;
+        for (auto& p : chain_) {
+            if (p.first->reasons & reason) p.first->callback(T, p.second);
+        }
+    }
+
+ private:
+    std::vector<std::pair<const MipPlugin*, void*>> chain_;
+    int reasons_;
+};
+
+namespace plugins {
+
+    // branches on the fractional variable with the largest fractionality weighted by its objective
+    // coefficient, towards the nearest integer
+    static void ObjWeightedBranch(glp_tree* T, void*) {
+        glp_prob* P = glp_ios_get_prob(T);
+        int n = glp_get_num_cols(P), best = 0;
+        double score = -1.0, frac = 0.0;
+        for (int j = 1; j <= n; j++) {
+            if (!glp_ios_can_branch(T, j)) continue;
+            double x = glp_get_col_prim(P, j);
+            double f = x - floor(x);
+            double s = (f < 0.5 ? f : 1.0 - f) * (1.0 + fabs(glp_get_obj_coef(P, j)));
+            if (s > score) {
+                score = s;
+                best = j;
+                frac = f;
+            }
+        }
+        if (best) glp_ios_branch_upon(T, best, frac > 0.5 ? GLP_UP_BRNCH : GLP_DN_BRNCH);
+    }
+
+    struct RoundingState {
+        std::vector<double> x, val;
+        std::vector<int> ind;
+    };
+
+    static void* RoundingCreate() { return new RoundingState(); }
+    static void RoundingDestroy(void* state) { delete static_cast<RoundingState*>(state); }
+
+    // rounds the integer columns of the LP solution to the nearest integer and proposes the point
+    // when it satisfies every row, cuts included
+    static void RoundingHeur(glp_tree* T, void* state) {
+        RoundingState* s = static_cast<RoundingState*>(state);
+        glp_prob* P = glp_ios_get_prob(T);
+        int m = glp_get_num_rows(P), n = glp_get_num_cols(P);
+        s->x.assign(n + 1, 0.0);
+        s->ind.resize(n + 1);
+        s->val.resize(n + 1);
+        for (int j = 1; j <= n; j++) {
+            double x = glp_get_col_prim(P, j);
+            s->x[j] = glp_get_col_kind(P, j) == GLP_CV ? x : floor(x + 0.5);
+        }
+        for (int i = 1; i <= m; i++) {
+            int type = glp_get_row_type(P, i);
+            if (type == GLP_FR) continue;
+            int len = glp_get_mat_row(P, i, s->ind.data(), s->val.data());
+            double r = 0.0;
+            for (int k = 1; k <= len; k++) r += s->val[k] * s->x[s->ind[k]];
+            if (type == GLP_LO || type == GLP_DB || type == GLP_FX) {
+                double lb = glp_get_row_lb(P, i);
+                if (r < lb - 1e-6 * (1.0 + fabs(lb))) return;
+            }
+            if (type == GLP_UP || type == GLP_DB || type == GLP_FX) {
+                double ub = glp_get_row_ub(P, i);
+                if (r > ub + 1e-6 * (1.0 + fabs(ub))) return;
+            }
+        }
+        glp_ios_heur_sol(T, s->x.data());
+    }
+
+}  // namespace plugins
+
+inline MipPlugins::MipPlugins() {
+    Add({"objWeightedBranch", GLP_FBRANCH, plugins::ObjWeightedBranch, NULL, NULL});
+    Add({"roundingHeur", GLP_FHEUR, plugins::RoundingHeur, plugins::RoundingCreate, plugins::RoundingDestroy});
+}
+
+}  // namespace NodeGLPK
+#endif
@@ -2,9 +2,14 @@
 #ifndef _NODE_GLPK_PROBLEM_HPP
 #define _NODE_GLPK_PROBLEM_HPP
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <memory>
 #include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
 
 #include <node.h>
 #include <node_object_wrap.h>
@@ -16,6 +21,12 @@
 
 #include "glpk/glpk.h"
 #include "common.h"
+#include "descriptor.hpp"
+#include "miprace.hpp"
+#include "opqueue.hpp"
+#include "parallelmip.hpp"
+#include "plugins.hpp"
+#include "scheduler.hpp"
 #include "tree.hpp"
 #include "nodeglpk.hpp"
 
@@ -33,6 +44,8 @@ namespace NodeGLPK {
             
             // Prototype
             Nan::SetPrototypeMethod(tpl, "on", On);
+            Nan::SetPrototypeMethod(tpl, "cancel", Cancel);
+            Nan::SetPrototypeMethod(tpl, "enqueue", Enqueue);
             Nan::SetPrototypeMethod(tpl, "setProbName", SetProbName);
             Nan::SetPrototypeMethod(tpl, "getProbName", GetProbName);
             Nan::SetPrototypeMethod(tpl, "setObjDir", SetObjDir);
@@ -41,23 +54,28 @@ namespace NodeGLPK {
             Nan::SetPrototypeMethod(tpl, "setRowName", SetRowName);
             Nan::SetPrototypeMethod(tpl, "getRowName", GetRowName);
             Nan::SetPrototypeMethod(tpl, "setRowBnds", SetRowBnds);
+            Nan::SetPrototypeMethod(tpl, "setRowBndsArray", SetRowBndsArray);
             Nan::SetPrototypeMethod(tpl, "addCols", AddCols);
             Nan::SetPrototypeMethod(tpl, "setColName", SetColName);
             Nan::SetPrototypeMethod(tpl, "getColName", GetColName);
             Nan::SetPrototypeMethod(tpl, "setColBnds", SetColBnds);
+            Nan::SetPrototypeMethod(tpl, "setColBndsArray", SetColBndsArray);
             Nan::SetPrototypeMethod(tpl, "setObjCoef", SetObjCoef);
+            Nan::SetPrototypeMethod(tpl, "setObjCoefArray", SetObjCoefArray);
             Nan::SetPrototypeMethod(tpl, "getObjCoef", GetObjCoef);
             Nan::SetPrototypeMethod(tpl, "loadMatrix", LoadMatrix);
             Nan::SetPrototypeMethod(tpl, "simplexSync", SimplexSync);
             Nan::SetPrototypeMethod(tpl, "simplex", Simplex);
             Nan::SetPrototypeMethod(tpl, "getObjVal", GetObjVal);
             Nan::SetPrototypeMethod(tpl, "getColPrim", GetColPrim);
+            Nan::SetPrototypeMethod(tpl, "getColPrimArray", GetColPrimArray);
             Nan::SetPrototypeMethod(tpl, "setObjName", SetObjName);
             Nan::SetPrototypeMethod(tpl, "getObjName", GetObjName);
             Nan::SetPrototypeMethod(tpl, "setMatRow", SetMatRow);
             Nan::SetPrototypeMethod(tpl, "getMatRow", GetMatRow);
             Nan::SetPrototypeMethod(tpl, "setMatCol", SetMatCol);
             Nan::SetPrototypeMethod(tpl, "getMatCol", GetMatCol);
+            Nan::SetPrototypeMethod(tpl, "getMatrix", GetMatrix);
             Nan::SetPrototypeMethod(tpl, "sortMatrix", SortMatrix);
             Nan::SetPrototypeMethod(tpl, "delRows", DelRows);
             Nan::SetPrototypeMethod(tpl, "delCols", DelCols);
@@ -87,7 +105,9 @@ namespace NodeGLPK {
             Nan::SetPrototypeMethod(tpl, "setRowStat", SetRowStat);
             Nan::SetPrototypeMethod(tpl, "setColStat", SetColStat);
             Nan::SetPrototypeMethod(tpl, "getRowStat", GetRowStat);
+            Nan::SetPrototypeMethod(tpl, "getRowStatArray", GetRowStatArray);
             Nan::SetPrototypeMethod(tpl, "getColStat", GetColStat);
+            Nan::SetPrototypeMethod(tpl, "getColStatArray", GetColStatArray);
             Nan::SetPrototypeMethod(tpl, "stdBasis", StdBasis);
             Nan::SetPrototypeMethod(tpl, "advBasis", AdvBasis);
             Nan::SetPrototypeMethod(tpl, "cpxBasis", CpxBasis);
@@ -97,13 +117,17 @@ namespace NodeGLPK {
             Nan::SetPrototypeMethod(tpl, "getPrimStat", GetPrimStat);
             Nan::SetPrototypeMethod(tpl, "getDualStat", GetDualStat);
             Nan::SetPrototypeMethod(tpl, "getRowPrim", GetRowPrim);
+            Nan::SetPrototypeMethod(tpl, "getRowPrimArray", GetRowPrimArray);
             Nan::SetPrototypeMethod(tpl, "getRowDual", GetRowDual);
+            Nan::SetPrototypeMethod(tpl, "getRowDualArray", GetRowDualArray);
             Nan::SetPrototypeMethod(tpl, "getColDual", GetColDual);
+            Nan::SetPrototypeMethod(tpl, "getColDualArray", GetColDualArray);
             Nan::SetPrototypeMethod(tpl, "getUnbndRay", GetUnbndRay);
             Nan::SetPrototypeMethod(tpl, "getItCnt", GetItCnt);
             Nan::SetPrototypeMethod(tpl, "setItCnt", SetItCnt);
             Nan::SetPrototypeMethod(tpl, "interiorSync", InteriorSync);
             Nan::SetPrototypeMethod(tpl, "interior", Interior);
+            Nan::SetPrototypeMethod(tpl, "solveConcurrent", SolveConcurrent);
             Nan::SetPrototypeMethod(tpl, "iptStatus", IptStatus);
             Nan::SetPrototypeMethod(tpl, "readMpsSync", ReadMpsSync);
             Nan::SetPrototypeMethod(tpl, "readMps", ReadMps);
@@ -111,15 +135,24 @@ namespace NodeGLPK {
             Nan::SetPrototypeMethod(tpl, "writeMps", WriteMps);
             Nan::SetPrototypeMethod(tpl, "iptObjVal", IptObjVal);
             Nan::SetPrototypeMethod(tpl, "iptRowPrim", IptRowPrim);
+            Nan::SetPrototypeMethod(tpl, "iptRowPrimArray", IptRowPrimArray);
             Nan::SetPrototypeMethod(tpl, "iptRowDual", IptRowDual);
+            Nan::SetPrototypeMethod(tpl, "iptRowDualArray", IptRowDualArray);
             Nan::SetPrototypeMethod(tpl, "iptColPrim", IptColPrim);
+            Nan::SetPrototypeMethod(tpl, "iptColPrimArray", IptColPrimArray);
             Nan::SetPrototypeMethod(tpl, "iptColDual", IptColDual);
+            Nan::SetPrototypeMethod(tpl, "iptColDualArray", IptColDualArray);
             Nan::SetPrototypeMethod(tpl, "setColKind", SetColKind);
+            Nan::SetPrototypeMethod(tpl, "setColKindArray", SetColKindArray);
             Nan::SetPrototypeMethod(tpl, "getColKind", GetColKind);
             Nan::SetPrototypeMethod(tpl, "getNumInt", GetNumInt);
             Nan::SetPrototypeMethod(tpl, "getNumBin", GetNumBin);
             Nan::SetPrototypeMethod(tpl, "intoptSync", IntoptSync);
             Nan::SetPrototypeMethod(tpl, "intopt", Intopt);
+            Nan::SetPrototypeMethod(tpl, "scheduleSimplex", ScheduleSimplex);
+            Nan::SetPrototypeMethod(tpl, "scheduleIntopt", ScheduleIntopt);
+            Nan::SetPrototypeMethod(tpl, "pause", Pause);
+            Nan::SetPrototypeMethod(tpl, "resume", Resume);
             Nan::SetPrototypeMethod(tpl, "readProbSync", ReadProbSync);
             Nan::SetPrototypeMethod(tpl, "readProb", ReadProb);
             Nan::SetPrototypeMethod(tpl, "writeProbSync", WriteProbSync);
@@ -131,7 +164,9 @@ namespace NodeGLPK {
             Nan::SetPrototypeMethod(tpl, "mipStatus", MipStatus);
             Nan::SetPrototypeMethod(tpl, "mipObjVal", MipObjVal);
             Nan::SetPrototypeMethod(tpl, "mipRowVal", MipRowVal);
+            Nan::SetPrototypeMethod(tpl, "mipRowValArray", MipRowValArray);
             Nan::SetPrototypeMethod(tpl, "mipColVal", MipColVal);
+            Nan::SetPrototypeMethod(tpl, "mipColValArray", MipColValArray);
             Nan::SetPrototypeMethod(tpl, "checkKkt", CheckKkt);
             Nan::SetPrototypeMethod(tpl, "printSolSync", PrintSolSync);
             Nan::SetPrototypeMethod(tpl, "printSol", PrintSol);
@@ -165,7 +200,10 @@ namespace NodeGLPK {
             Nan::SetPrototypeMethod(tpl, "memStats", MemStats);
             
             constructor.Reset(tpl);
-            exports->Set(Nan::New<String>("Problem").ToLocalChecked(), tpl->GetFunction());
+            Local<Function> fn = tpl->GetFunction();
+            Nan::SetMethod(fn, "fromDescriptor", FromDescriptor);
+            exports->Set(Nan::New<String>("Problem").ToLocalChecked(), fn);
+            exports->Set(Nan::New<String>("solveBatch").ToLocalChecked(), Nan::New<FunctionTemplate>(SolveBatch)->GetFunction());
         }
         
         static bool SmcpInit(glp_smcp* scmp, Local<Value> value){
@@ -218,6 +256,12 @@ namespace NodeGLPK {
                 } else if (keystr == "presolve"){
                     V8CHECKBOOL(!val->IsInt32(), "presolve: should be int32");
                     scmp->presolve = val->Int32Value();
+                } else if (keystr == "simd"){
+                    V8CHECKBOOL(!val->IsInt32(), "simd: should be int32");
+                    scmp->simd = val->Int32Value();
+                } else if (keystr == "partLen"){
+                    V8CHECKBOOL(!val->IsInt32(), "partLen: should be int32");
+                    scmp->part_len = val->Int32Value();
                 } else {
                     std::string error("Unknow field: ");
                     error += keystr;
@@ -233,6 +277,9 @@ namespace NodeGLPK {
              info_{std::make_shared<HookInfo>(emitter_)},
              env_state_(make_shared_environ_state(info_)),
              counters_{0,0,0,0},
+             queue_running_{false},
+             cancel_{0},
+             job_{NULL},
             thread{false}{
 
            GLPKEnvStateGuard stateguard{env_state_, info_}; 
@@ -240,6 +287,8 @@ namespace NodeGLPK {
         }
 
         ~Problem(){
+            for (auto op : queued_) delete op;
+            for (auto op : settled_) delete op;
             if (handle) {
                 GLPKEnvStateGuard stateguard{env_state_, info_}; 
                 glp_delete_prob(handle);
@@ -270,6 +319,22 @@ namespace NodeGLPK {
             lp->emitter_->on(s, callback);
         }
 
+        // cancel(): asks the running async simplex, exact or interior-point solve, or a search with
+        // threads > 1, to stop, its callback then gets glp.ECANCEL (glp.ESTOP for the searches);
+        // returns false when no async operation is in progress
+        static NAN_METHOD(Cancel) {
+            V8CHECK(info.Length() != 0, "Wrong number of arguments");
+
+            Problem* lp = ObjectWrap::Unwrap<Problem>(info.Holder());
+            V8CHECK(!lp->handle, "object deleted");
+
+            bool running = lp->thread.load();
+            if (running) lp->cancel_ = 1;
+            // a paused search has to run once more to stop
+            if (lp->job_) MipScheduler::Instance().Resume(lp->job_);
+            info.GetReturnValue().Set(running);
+        }
+
         static NAN_METHOD(MemStats) {
             V8CHECK(info.Length() != 0, "Wrong number of arguments");
 
@@ -293,29 +358,89 @@ namespace NodeGLPK {
             V8CHECK(!info[0]->IsInt32() || !info[1]->IsInt32Array()
                     || !info[2]->IsInt32Array() || !info[3]->IsFloat64Array(), "Wrong arguments");
             
-            Local<Int32Array> ia = Local<Int32Array>::Cast(info[1]);
-            Local<Int32Array> ja = Local<Int32Array>::Cast(info[2]);
-            Local<Float64Array> ar = Local<Float64Array>::Cast(info[3]);
+            // GLPK only reads from these arrays, so they are passed straight from the ArrayBuffer backing stores
+            Nan::TypedArrayContents<int> ia(info[1]);
+            Nan::TypedArrayContents<int> ja(info[2]);
+            Nan::TypedArrayContents<double> ar(info[3]);
             
-            int* pia = new int[ia->Length()];
-            int* pja = new int[ja->Length()];
-            double* par = new double[ar->Length()];
-            
-            for (size_t i = 0; i < ia->Length(); i++) pia[i] = ia->Get(i)->Int32Value();
-            for (size_t i = 0; i < ja->Length(); i++) pja[i] = ja->Get(i)->Int32Value();
-            for (size_t i = 0; i < ar->Length(); i++) par[i] = ar->Get(i)->NumberValue();
+            int ne = info[0]->Int32Value();
+            V8CHECK(ne < 0, "Invalid number of elements");
+            V8CHECK((ia.length() <= (size_t)ne) || (ja.length() <= (size_t)ne) || (ar.length() <= (size_t)ne),
+                    "Invalid arrays length");
             
             Problem* lp = ObjectWrap::Unwrap<Problem>(info.Holder());
             V8CHECK(!lp->handle, "object deleted");
             V8CHECK(lp->thread.load(), "an async operation is inprogress");
             
             GLP_CREATE_HOOK_GUARDS(lp); 
-            GLP_CATCH(glp_load_matrix(lp->handle, info[0]->Int32Value(), pia, pja, par);)
+            GLP_CATCH(glp_load_matrix(lp->handle, ne, *ia, *ja, *ar);)
+        }
 
-            
-            delete[] pia;
-            delete[] pja;
-            delete[] par;
+        class FromDescriptorWorker : public Nan::AsyncWorker {
+        public:
+            FromDescriptorWorker(Nan::Callback *callback, Problem *lp, const ProblemDescriptor& desc)
+            : Nan::AsyncWorker(callback), lp(lp), desc(desc){}
+
+            void WorkComplete() {
+                lp->thread = false;
+                Nan::AsyncWorker::WorkComplete();
+            }
+
+            void Execute () {
+                std::string error = desc.Validate();
+                if (!error.empty()) {
+                    SetErrorMessage(error.c_str());
+                    return;
+                }
+                try {
+                    desc.Build(lp->handle);
+                } catch (std::string s){
+                    SetErrorMessage(s.c_str());
+                }
+            }
+
+            void HandleOKCallback() {
+                Local<Value> info[] = {Nan::Null(), GetFromPersistent("problem")};
+                callback->Call(2, info);
+            }
+        public:
+            Problem *lp;
+            ProblemDescriptor desc;
+        };
+
+        // Problem.fromDescriptor(desc[, callback]): builds a whole problem in one native call,
+        // see descriptor.hpp for the layout of desc
+        static NAN_METHOD(FromDescriptor) {
+            V8CHECK(info.Length() < 1 || info.Length() > 2, "Wrong number of arguments");
+            V8CHECK(info.Length() == 2 && !info[1]->IsFunction(), "Wrong arguments");
+
+            ProblemDescriptor desc;
+            std::vector<Local<Value> > pins;
+            if (!desc.Parse(info[0], &pins)) return;
+
+            Local<Function> cons = Nan::New<FunctionTemplate>(constructor)->GetFunction();
+            Local<Object> ret = Nan::NewInstance(cons).ToLocalChecked();
+            Problem* lp = ObjectWrap::Unwrap<Problem>(ret);
+
+            if (info.Length() == 1) {
+                std::string error = desc.Validate();
+                V8CHECK(!error.empty(), error.c_str());
+
+                GLP_CREATE_HOOK_GUARDS(lp);
+                GLP_CATCH_RET(desc.Build(lp->handle);)
+                info.GetReturnValue().Set(ret);
+                return;
+            }
+
+            Nan::Callback *callback = new Nan::Callback(info[1].As<Function>());
+            FromDescriptorWorker *worker = new FromDescriptorWorker(callback, lp, desc);
+            // the typed arrays are read in place by the worker, keep them alive until it completes
+            worker->SaveToPersistent("problem", ret);
+            for (size_t k = 0; k < pins.size(); k++)
+                worker->SaveToPersistent((uint32_t)k, pins[k]);
+            lp->thread = true;
+            GLPKEnvStateDecorator* decorated = new GLPKEnvStateDecorator(worker, lp->emitter_, lp->env_state_);
+            QueueWorker(decorated);
         }
 
         static NAN_METHOD(SimplexSync) {
@@ -340,10 +465,11 @@ namespace NodeGLPK {
         class SimplexWorker : public Nan::AsyncWorker {
         public:
             SimplexWorker(Nan::Callback *callback, Problem *lp)
-            : Nan::AsyncWorker(callback), lp(lp){
+            : Nan::AsyncWorker(callback), lp(lp), ret(0){
 
                 GLP_CREATE_HOOK_GUARDS(lp); 
                 glp_init_smcp(&smcp);
+                smcp.abort = &lp->cancel_;
                 lp->emitter_->emit("initialized", "Complete");
             }
 
@@ -354,14 +480,20 @@ namespace NodeGLPK {
 
             void Execute () {
                 try {
-                    glp_simplex(lp->handle, &smcp);
+                    ret = glp_simplex(lp->handle, &smcp);
                 } catch (std::string s){
                     SetErrorMessage(s.c_str());
                 }
             }
+
+            void HandleOKCallback() {
+                Local<Value> info[] = {Nan::Null(), Nan::New<Int32>(ret)};
+                callback->Call(2, info);
+            }
         public:
             Problem *lp;
             glp_smcp smcp;
+            int ret;
         };
         
         static NAN_METHOD(Simplex) {
@@ -378,9 +510,10 @@ namespace NodeGLPK {
                 worker->Destroy();
                 return;
             }
+            lp->cancel_ = 0;
             lp->thread = true;
             GLPKEnvStateDecorator* decorated = new GLPKEnvStateDecorator(worker, lp->emitter_, lp->env_state_);
-            Nan::AsyncQueueWorker(decorated);
+            QueueWorker(decorated);
         }
         
         static NAN_METHOD(ExactSync) {
@@ -404,12 +537,155 @@ namespace NodeGLPK {
             )
         }
         
+        // common part of the jobs run in slices by the MipScheduler, see ScheduleSimplex and ScheduleIntopt
+        class ScheduledJob : public SlicedJob {
+        public:
+            ScheduledJob(Nan::Callback *callback, Problem *lp, int priority, int64_t deadline)
+            : SlicedJob(callback, priority, deadline), lp(lp), progress(NULL) {}
+
+            ~ScheduledJob(){
+                delete progress;
+            }
+
+            void WorkComplete() {
+                lp->thread = false;
+                lp->job_ = NULL;
+                Nan::AsyncWorker::WorkComplete();
+            }
+
+            Problem *lp;
+            Nan::Callback *progress;
+        };
+
+        // parses {priority, deadline, progress}; deadline is in milliseconds from now
+        static bool ScheduleOptsInit(Local<Value> value, int* priority, int64_t* deadline, Local<Value>* progress) {
+            *priority = 0;
+            *deadline = 0;
+            *progress = Nan::Undefined();
+            if (!value->IsObject()) return true;
+            Local<Object> obj = value->ToObject();
+            Local<Value> val = obj->Get(Nan::New<String>("priority").ToLocalChecked());
+            if (!val->IsUndefined()) {
+                V8CHECKBOOL(!val->IsInt32(), "priority: should be int32");
+                *priority = val->Int32Value();
+            }
+            val = obj->Get(Nan::New<String>("deadline").ToLocalChecked());
+            if (!val->IsUndefined()) {
+                V8CHECKBOOL(!val->IsNumber() || val->NumberValue() < 0, "deadline: should be a non-negative number");
+                *deadline = MipScheduler::Now() + (int64_t)(val->NumberValue() * 1e6);
+            }
+            *progress = obj->Get(Nan::New<String>("progress").ToLocalChecked());
+            V8CHECKBOOL(!((*progress)->IsUndefined() || (*progress)->IsFunction()), "progress: should be a function");
+            return true;
+        }
+
+        static void Schedule(ScheduledJob* job, Local<Value> progress, Local<Object> holder) {
+            Problem* lp = job->lp;
+            if (progress->IsFunction()) job->progress = new Nan::Callback(progress.As<Function>());
+            lp->thread = true;
+            lp->cancel_ = 0;
+            lp->job_ = job;
+            job->SaveToPersistent("problem", holder);
+            MipScheduler::Instance().Submit(job);
+        }
+
+        // a simplex search stepped by the MipScheduler through glp_simplex_run; the working LP, the
+        // factorization and the pricing data stay in the context between slices
+        class ScheduledSimplexJob : public ScheduledJob {
+        public:
+            ScheduledSimplexJob(Nan::Callback *callback, Problem *lp, int priority, int64_t deadline)
+            : ScheduledJob(callback, lp, priority, deadline), started(false), iterations(0) {
+                glp_init_smcp(&smcp);
+                glp_init_smx_ctx(&ctx);
+                ctx.parm = &smcp;
+            }
+
+            bool Step(int64_t until, int budget) {
+                auto info = std::make_shared<HookInfo>(nullptr, nullptr);
+                GLPKEnvStateGuard guard{lp->env_state_, info};
+                try {
+                    if (!started) {
+                        started = true;
+                        smcp.abort = &lp->cancel_;
+                        glp_simplex_start(lp->handle, &ctx);
+                    }
+                    int64_t now = MipScheduler::Now();
+                    if (deadline && now >= deadline) lp->cancel_ = 1;
+                    if (deadline && (!until || deadline < until)) until = deadline;
+                    if (!ctx.done) {
+                        int tm_lim = until ? std::max<int>(1, (int)((until - now) / 1000000)) : 0;
+                        glp_simplex_run(&ctx, budget, tm_lim);
+                    }
+                    iterations = ctx.it_cnt;
+                    if (ctx.done) {
+                        glp_simplex_stop(lp->handle, &ctx);
+                        return true;
+                    }
+                } catch (std::string s){
+                    SetErrorMessage(s.c_str());
+                    return true;
+                }
+                return false;
+            }
+
+            void Progress() {
+                if (!progress) return;
+                Local<Object> result = Nan::New<Object>();
+                result->Set(Nan::New<String>("iterations").ToLocalChecked(), Nan::New<Int32>(iterations.load()));
+                Local<Value> info[] = {result};
+                progress->Call(1, info);
+            }
+
+            void HandleOKCallback() {
+                Local<Value> info[] = {Nan::Null(), Nan::New<Int32>(ctx.ret)};
+                callback->Call(2, info);
+            }
+
+            glp_smcp smcp;
+            glp_smx_ctx ctx;
+            bool started;
+            std::atomic<int> iterations;
+        };
+
+        // scheduleSimplex(smcp, {priority, deadline, progress}, callback): like simplex, but the search runs
+        // in slices on the MipScheduler threads, so that it can be paused and resumed; it is cancelled
+        // with ECANCEL once the deadline (milliseconds from now) is reached
+        static NAN_METHOD(ScheduleSimplex) {
+            V8CHECK(info.Length() != 3, "Wrong number of arguments");
+            V8CHECK(!(info[0]->IsObject() || info[0]->IsNull()) || !(info[1]->IsObject() || info[1]->IsNull())
+                    || !info[2]->IsFunction(), "Wrong arguments");
+
+            Problem* lp = ObjectWrap::Unwrap<Problem>(info.Holder());
+            V8CHECK(!lp->handle, "object deleted");
+            V8CHECK(lp->thread.load(), "an async operation is inprogress");
+
+            int priority;
+            int64_t deadline;
+            Local<Value> progress;
+            if (!ScheduleOptsInit(info[1], &priority, &deadline, &progress)) return;
+
+            Nan::Callback *callback = new Nan::Callback(info[2].As<Function>());
+            ScheduledSimplexJob *job = new ScheduledSimplexJob(callback, lp, priority, deadline);
+            if (info[0]->IsObject() && !SmcpInit(&job->smcp, info[0])) {
+                job->Destroy();
+                return;
+            }
+            if (job->smcp.meth == GLP_SIFTING) {
+                // sifting solves a sequence of working LPs, which glp_simplex_run cannot step through
+                Nan::ThrowTypeError("meth: SIFTING is not available in a scheduled job");
+                job->Destroy();
+                return;
+            }
+            Schedule(job, progress, info.Holder());
+        }
+
         class ExactWorker : public Nan::AsyncWorker {
         public:
             ExactWorker(Nan::Callback *callback, Problem *lp)
-            : Nan::AsyncWorker(callback), lp(lp){
+            : Nan::AsyncWorker(callback), lp(lp), ret(0){
                 GLP_CREATE_HOOK_GUARDS(lp); 
                 glp_init_smcp(&smcp);
+                smcp.abort = &lp->cancel_;
             }
             void WorkComplete() {
                 lp->thread = false;
@@ -418,15 +694,21 @@ namespace NodeGLPK {
 
             void Execute () {
                 try {
-                    glp_exact(lp->handle, &smcp);
+                    ret = glp_exact(lp->handle, &smcp);
                 } catch (std::string s){
                     SetErrorMessage(s.c_str());
                 }
             }
+
+            void HandleOKCallback() {
+                Local<Value> info[] = {Nan::Null(), Nan::New<Int32>(ret)};
+                callback->Call(2, info);
+            }
         private:
         public:
             Problem *lp;
             glp_smcp smcp;
+            int ret;
         };
         
         static NAN_METHOD(Exact) {
@@ -443,9 +725,10 @@ namespace NodeGLPK {
                 worker->Destroy();
                 return;
             }
+            lp->cancel_ = 0;
             lp->thread = true;
             GLPKEnvStateDecorator* decorated = new GLPKEnvStateDecorator(worker, lp->emitter_, lp->env_state_);
-            Nan::AsyncQueueWorker(decorated);
+            QueueWorker(decorated);
         }
         
         static bool IptcpInit(glp_iptcp* iptcp, Local<Value> value){
@@ -493,9 +776,10 @@ namespace NodeGLPK {
         class InteriorWorker : public Nan::AsyncWorker {
         public:
             InteriorWorker(Nan::Callback *callback, Problem *lp)
-            : Nan::AsyncWorker(callback), lp(lp){
+            : Nan::AsyncWorker(callback), lp(lp), ret(0){
                 GLP_CREATE_HOOK_GUARDS(lp); 
                 glp_init_iptcp(&iptcp);
+                iptcp.abort = &lp->cancel_;
             }
             void WorkComplete() {
                 lp->thread = false;
@@ -503,15 +787,21 @@ namespace NodeGLPK {
             }
             void Execute () {
                 try {
-                    glp_interior(lp->handle, &iptcp);
+                    ret = glp_interior(lp->handle, &iptcp);
                 } catch (std::string s){
                     SetErrorMessage(s.c_str());
                 }
             }
+
+            void HandleOKCallback() {
+                Local<Value> info[] = {Nan::Null(), Nan::New<Int32>(ret)};
+                callback->Call(2, info);
+            }
         private:
         public:
             Problem *lp;
             glp_iptcp iptcp;
+            int ret;
             
         };
         
@@ -529,11 +819,173 @@ namespace NodeGLPK {
                 worker->Destroy();
                 return;
             }
+            lp->cancel_ = 0;
             lp->thread = true;
             GLPKEnvStateDecorator* decorated = new GLPKEnvStateDecorator(worker, lp->emitter_, lp->env_state_);
-            Nan::AsyncQueueWorker(decorated);
+            QueueWorker(decorated);
         }
-        
+
+        class ConcurrentWorker : public Nan::AsyncWorker {
+        public:
+            enum Solver { PRIMAL, DUAL, INTERIOR, SOLVERS };
+
+            // shared with the racing threads, which may outlive the worker
+            struct Race {
+                Race() : copied(0), finished(0), winner(-1), collected(false), clone(NULL), stop(0) {}
+                std::mutex lock;
+                std::condition_variable cond;
+                int copied, finished, winner;
+                bool collected;
+                glp_prob *clone;
+                int ret[SOLVERS];
+                volatile int stop;
+            };
+
+            ConcurrentWorker(Nan::Callback *callback, Problem *lp)
+            : Nan::AsyncWorker(callback), lp(lp), winner(-1), ret(0){
+                GLP_CREATE_HOOK_GUARDS(lp);
+                glp_init_smcp(&smcp);
+                glp_init_iptcp(&iptcp);
+            }
+            void WorkComplete() {
+                lp->thread = false;
+                Nan::AsyncWorker::WorkComplete();
+            }
+
+            // every solver works on its own copy in its own GLPK environment; the first one to return
+            // 0 hands its solution over, the others are cancelled
+            void Execute () {
+                PrepareCopies(lp->handle);
+
+                std::shared_ptr<Race> race = std::make_shared<Race>();
+                for (int s = 0; s < SOLVERS; s++)
+                    std::thread(Run, race, s, lp->handle, smcp, iptcp).detach();
+
+                // the racing solvers cannot see lp->cancel_, forward it while waiting
+                std::unique_lock<std::mutex> lock(race->lock);
+                while (!race->cond.wait_for(lock, std::chrono::milliseconds(5), [&race] {
+                    return race->copied == SOLVERS && (race->winner >= 0 || race->finished == SOLVERS);
+                })) {
+                    if (lp->cancel_) race->stop = 1;
+                }
+                race->stop = 1;
+                winner = race->winner;
+                if (winner < 0) {
+                    ret = race->ret[PRIMAL];
+                    return;
+                }
+                ret = race->ret[winner];
+                try {
+                    glp_copy_sol(lp->handle, race->clone, winner == INTERIOR ? GLP_IPT : GLP_SOL);
+                } catch (std::string s){
+                    SetErrorMessage(s.c_str());
+                }
+                race->collected = true;
+                race->cond.notify_all();
+            }
+
+            void HandleOKCallback() {
+                static const char* names[] = {"primal", "dual", "interior"};
+                Local<Object> result = Nan::New<Object>();
+                result->Set(Nan::New<String>("ret").ToLocalChecked(), Nan::New<Int32>(ret));
+                if (winner < 0)
+                    result->Set(Nan::New<String>("winner").ToLocalChecked(), Nan::Null());
+                else
+                    result->Set(Nan::New<String>("winner").ToLocalChecked(), Nan::New<String>(names[winner]).ToLocalChecked());
+                Local<Value> info[] = {Nan::Null(), result};
+                callback->Call(2, info);
+            }
+
+        private:
+            static void Run(std::shared_ptr<Race> race, int s, glp_prob* source, glp_smcp smcp, glp_iptcp iptcp) {
+                glp_term_out(GLP_OFF);
+                HookErrors();
+                smcp.abort = iptcp.abort = &race->stop;
+                glp_prob* P = glp_create_prob();
+                int ret = 0;
+                try {
+                    glp_copy_prob(P, source, GLP_OFF);
+                } catch (std::string){
+                    ret = -1;
+                }
+                {
+                    std::lock_guard<std::mutex> lock(race->lock);
+                    race->copied++;
+                }
+                race->cond.notify_all();
+
+                if (ret == 0) {
+                    try {
+                        if (s == INTERIOR) {
+                            ret = glp_interior(P, &iptcp);
+                        } else {
+                            smcp.meth = (s == PRIMAL) ? GLP_PRIMAL : GLP_DUALP;
+                            ret = glp_simplex(P, &smcp);
+                        }
+                    } catch (std::string){
+                        ret = -1;
+                    }
+                }
+
+                std::unique_lock<std::mutex> lock(race->lock);
+                race->ret[s] = ret;
+                if (ret == 0 && race->winner < 0) {
+                    race->winner = s;
+                    race->clone = P;
+                    race->cond.notify_all();
+                    race->cond.wait(lock, [&race] { return race->collected; });
+                }
+                race->finished++;
+                race->cond.notify_all();
+                lock.unlock();
+
+                // after an error glp_free_env releases P
+                if (ret != -1) glp_delete_prob(P);
+                glp_free_env();
+            }
+
+        public:
+            Problem *lp;
+            glp_smcp smcp;
+            glp_iptcp iptcp;
+            int winner, ret;
+        };
+
+        // solveConcurrent({simplex, interior}, callback): races primal simplex, dual simplex and the
+        // interior-point method on copies of the problem and keeps the solution of the first one done;
+        // cancel() stops all three
+        static NAN_METHOD(SolveConcurrent) {
+            V8CHECK(info.Length() != 2, "Wrong number of arguments");
+            V8CHECK(!(info[0]->IsObject() || info[0]->IsNull()) || !info[1]->IsFunction(), "Wrong arguments");
+
+            Problem* lp = ObjectWrap::Unwrap<Problem>(info.Holder());
+            V8CHECK(!lp->handle, "object deleted");
+            V8CHECK(lp->thread.load(), "an async operation is inprogress");
+
+            Local<Value> simplex = Nan::Undefined(), interior = Nan::Undefined();
+            if (info[0]->IsObject()) {
+                Local<Object> opts = info[0]->ToObject();
+                simplex = opts->Get(Nan::New<String>("simplex").ToLocalChecked());
+                interior = opts->Get(Nan::New<String>("interior").ToLocalChecked());
+                V8CHECK(!(simplex->IsUndefined() || simplex->IsObject()), "simplex: should be an object");
+                V8CHECK(!(interior->IsUndefined() || interior->IsObject()), "interior: should be an object");
+            }
+
+            Nan::Callback *callback = new Nan::Callback(info[1].As<Function>());
+            ConcurrentWorker *worker = new ConcurrentWorker(callback, lp);
+            bool ok = true;
+            if (simplex->IsObject()) ok = SmcpInit(&worker->smcp, simplex);
+            if (ok) ok = IptcpInit(&worker->iptcp, interior);
+            if (!ok){
+                worker->Destroy();
+                return;
+            }
+            lp->cancel_ = 0;
+            lp->thread = true;
+            GLPKEnvStateDecorator* decorated = new GLPKEnvStateDecorator(worker, lp->emitter_, lp->env_state_);
+            QueueWorker(decorated);
+        }
+
         static bool MpscpInit(glp_mpscp *mpscp, Local<Value> value){
             if (value->IsObject()){
                 Local<Object> obj = value->ToObject();
@@ -636,7 +1088,7 @@ namespace NodeGLPK {
             }
             lp->thread = true;
             GLPKEnvStateDecorator* decorated = new GLPKEnvStateDecorator(worker, lp->emitter_, lp->env_state_);
-            Nan::AsyncQueueWorker(decorated);
+            QueueWorker(decorated);
         }
         
         static NAN_METHOD(WriteMpsSync) {
@@ -712,14 +1164,19 @@ namespace NodeGLPK {
             }
             lp->thread = true;
             GLPKEnvStateDecorator* decorated = new GLPKEnvStateDecorator(worker, lp->emitter_, lp->env_state_);
-            Nan::AsyncQueueWorker(decorated);
+            QueueWorker(decorated);
         }
  
         struct IocpCallbackInfo {
             IocpCallbackInfo(Nan::Callback* cb, std::shared_ptr<glp_environ_state_t> ms) : callback(cb), env_state_(ms) {}
-            ~IocpCallbackInfo() noexcept { delete callback; }
+            ~IocpCallbackInfo() noexcept {
+                delete callback;
+                tree.Reset();
+            }
             Nan::Callback* callback;
             std::shared_ptr<glp_environ_state_t> env_state_;
+            // the Tree passed to every callback of the run, created by the first one
+            Nan::Persistent<Object> tree;
         };
        
         
@@ -727,16 +1184,38 @@ namespace NodeGLPK {
         static void IocpCallback(glp_tree *T, void *info){
             IocpCallbackInfo* cbinfo = static_cast<IocpCallbackInfo*>(info);
             const unsigned argc = 1;
-            Local<Value> t = Tree::Instantiate(T, cbinfo->env_state_);
-            Local<Value> argv[argc] = {Nan::New<Value>(t)};
+            Local<Object> t;
+            if (cbinfo->tree.IsEmpty()) {
+                t = Tree::Instantiate(T, cbinfo->env_state_)->ToObject();
+                cbinfo->tree.Reset(t);
+            } else {
+                t = Nan::New(cbinfo->tree);
+            }
+            Tree* host = ObjectWrap::Unwrap<Tree>(t);
+            host->Bind(T);
+            Local<Value> argv[argc] = {t};
             cbinfo->callback->Call(argc, argv);
-            Tree* host = ObjectWrap::Unwrap<Tree>(t->ToObject());
-            host->thread = true;
-            host->handle = NULL;
+            host->Release();
         };
         
         
-        static bool IocpInit(Problem* lp, glp_iocp *iocp, Local<Value> value){
+        // cb_info of a synchronous search with plug-ins, `js` is the IocpCallbackInfo of cbFunc or NULL
+        struct PluginCallbackInfo {
+            MipPluginChain* plugins;
+            void* js;
+            int reasons;
+        };
+
+        static void PluginCallback(glp_tree *T, void *info){
+            PluginCallbackInfo* cbinfo = static_cast<PluginCallbackInfo*>(info);
+            cbinfo->plugins->Run(T);
+            if (cbinfo->js && ((1 << glp_ios_reason(T)) & cbinfo->reasons)) IocpCallback(T, cbinfo->js);
+        }
+
+        // `progress` receives cbProgress, which only the async intopt accepts, `plugins` the native
+        // plug-ins, which the queued and batched intopt do not take
+        static bool IocpInit(Problem* lp, glp_iocp *iocp, Local<Value> value, Local<Value>* progress = NULL,
+                             std::unique_ptr<MipPluginChain>* plugins = NULL, Local<Value>* race = NULL){
             if (value->IsObject()){
                 Local<Object> obj = value->ToObject();
                 Local<Array> props = obj->GetPropertyNames();
@@ -819,12 +1298,70 @@ namespace NodeGLPK {
                     } else if (keystr == "cbReasons"){
                         V8CHECKBOOL(!val->IsInt32(), "cbReason: should be int32");
                         iocp->cb_reasons = val->Int32Value();
+                    } else if (keystr == "cbProgress"){
+                        V8CHECKBOOL(!progress, "cbProgress: only available in intopt");
+                        V8CHECKBOOL(!val->IsFunction(), "cbProgress: should be a function");
+                        *progress = val;
+                    } else if (keystr == "plugins"){
+                        V8CHECKBOOL(!plugins, "plugins: not available in a queued or batched intopt");
+                        V8CHECKBOOL(!val->IsArray(), "plugins: should be an array of names");
+                        Local<Array> names = Local<Array>::Cast(val);
+                        std::unique_ptr<MipPluginChain> chain(new MipPluginChain());
+                        for (uint32_t k = 0; k < names->Length(); k++) {
+                            V8CHECKBOOL(!names->Get(k)->IsString(), "plugins: should be an array of names");
+                            std::string name = std::string(V8TOCSTRING(names->Get(k)));
+                            const MipPlugin* plugin = MipPlugins::Instance().Find(name);
+                            std::string error("plugins: unknown plug-in ");
+                            error += name;
+                            V8CHECKBOOL(!plugin, error.c_str());
+                            chain->Add(plugin);
+                        }
+                        *plugins = std::move(chain);
+                    } else if (keystr == "threads"){
+                        V8CHECKBOOL(!val->IsInt32() || val->Int32Value() < 1, "threads: should be a positive int32");
+                        iocp->threads = val->Int32Value();
+                    } else if (keystr == "parDet"){
+                        V8CHECKBOOL(!val->IsInt32(), "parDet: should be int32");
+                        iocp->par_det = val->Int32Value();
+                    } else if (keystr == "parSeed"){
+                        V8CHECKBOOL(!val->IsInt32(), "parSeed: should be int32");
+                        iocp->par_seed = val->Int32Value();
+                    } else if (keystr == "rbRel"){
+                        V8CHECKBOOL(!val->IsInt32(), "rbRel: should be int32");
+                        iocp->rb_rel = val->Int32Value();
+                    } else if (keystr == "rbItLim"){
+                        V8CHECKBOOL(!val->IsInt32(), "rbItLim: should be int32");
+                        iocp->rb_it_lim = val->Int32Value();
+                    } else if (keystr == "rbThreads"){
+                        V8CHECKBOOL(!val->IsInt32(), "rbThreads: should be int32");
+                        iocp->rb_threads = val->Int32Value();
+                    } else if (keystr == "parCuts"){
+                        V8CHECKBOOL(!val->IsInt32(), "parCuts: should be int32");
+                        iocp->par_cuts = val->Int32Value();
+                    } else if (keystr == "race"){
+                        // the entries are read by IntoptRace
+                        V8CHECKBOOL(!race, "race: only available in intopt");
                     } else {
                         std::string error("Unknow field: ");
                         error += keystr;
                         V8CHECKBOOL(true, error.c_str());
                     }
                 }
+                // the parallel search has no glp_tree to hand over
+                V8CHECKBOOL(iocp->threads > 1 && (iocp->cb_info || (plugins && *plugins)
+                            || (progress && !(*progress)->IsUndefined())), "threads: cbFunc, cbProgress and plugins need threads: 1");
+                // nor cuts, heuristics, the branching on degradations or the backtracking techniques of
+                // glp_intopt, see ParallelMip: refuse them rather than search without
+                if (iocp->threads > 1) {
+                    V8CHECKBOOL(iocp->mir_cuts == GLP_ON || iocp->gmi_cuts == GLP_ON || iocp->cov_cuts == GLP_ON
+                                || iocp->clq_cuts == GLP_ON || iocp->par_cuts == GLP_ON,
+                                "threads: mirCuts, gmiCuts, covCuts, clqCuts and parCuts need threads: 1");
+                    V8CHECKBOOL(iocp->fp_heur == GLP_ON || iocp->ps_heur == GLP_ON, "threads: fpHeur and psHeur need threads: 1");
+                    V8CHECKBOOL(!obj->Get(Nan::New<String>("brTech").ToLocalChecked())->IsUndefined()
+                                && iocp->br_tech != GLP_BR_FFV && iocp->br_tech != GLP_BR_LFV && iocp->br_tech != GLP_BR_MFV,
+                                "threads: brTech DTH, PCH and RLB need threads: 1");
+                    V8CHECKBOOL(!obj->Get(Nan::New<String>("btTech").ToLocalChecked())->IsUndefined(), "threads: btTech needs threads: 1");
+                }
             }
             return true;
         }
@@ -840,9 +1377,23 @@ namespace NodeGLPK {
 
                       GLP_CREATE_HOOK_GUARDS(lp); 
                       glp_init_iocp(&iocp);
+                      std::unique_ptr<MipPluginChain> plugins;
                       if (info.Length() == 1) {
-                          if (IocpInit(lp, &iocp, info[0])) {
-                              glp_intopt(lp->handle, &iocp);
+                          if (IocpInit(lp, &iocp, info[0], NULL, &plugins)) {
+                              if (plugins) {
+                                  // the plug-ins come first, then cbFunc for the reasons asked for
+                                  PluginCallbackInfo cbinfo;
+                                  cbinfo.plugins = plugins.get();
+                                  cbinfo.js = iocp.cb_info;
+                                  cbinfo.reasons = iocp.cb_reasons;
+                                  glp_iocp parm = iocp;
+                                  parm.cb_func = PluginCallback;
+                                  parm.cb_info = &cbinfo;
+                                  parm.cb_reasons = plugins->Reasons() | (iocp.cb_info ? iocp.cb_reasons : 0);
+                                  glp_intopt(lp->handle, &parm);
+                              } else {
+                                  RunIntopt(lp->handle, &iocp);
+                              }
                           }
                       }
                       if (iocp.cb_info) delete static_cast<IocpCallbackInfo*>(iocp.cb_info);
@@ -852,15 +1403,30 @@ namespace NodeGLPK {
         
         class IntoptWorker : public Nan::AsyncWorker {
         public:
+           // one entry of the progress stream, see cbProgress
+           struct ProgressReport {
+               int reason, nodes, active;
+               double bound, incumbent, gap;
+               bool feasible;
+           };
+           // reports waiting for the main loop; the oldest ones are dropped beyond this
+           static const size_t kProgressQueue = 256;
+
            IntoptWorker(Nan::Callback* callback, Problem* lp)
                : Nan::AsyncWorker(callback),
                  parm_cb_done_{false},
+                 parm_cb_pending_(false),
                  notifier_(),
                  notify_lock_(),
                  parm_cb_async_(nullptr),
+                 progress_lock_(),
+                 progress_queue_(),
+                 dropped_(0),
                  lp(lp),
                  parm(),
-                 ctx() {
+                 ctx(),
+                 cb_reasons(0),
+                 progress(nullptr) {
                GLP_CREATE_HOOK_GUARDS(lp); 
                glp_init_iocp(&parm);
                glp_init_mip_ctx(&ctx);
@@ -875,21 +1441,28 @@ namespace NodeGLPK {
             ~IntoptWorker(){
                 if (parm.cb_info) delete static_cast<IocpCallbackInfo*>(parm.cb_info);
                 if (parm.save_sol) delete[] parm.save_sol;
+                delete progress;
             }
 
             void Execute() override {
                 try {
-                    // TODO(jrb): this whole start/run/stop thing depends on cb_func being set, but that's optional. It
-                    // might be better to just make this use the glp_intopt if cb_func is unset; going to check for
-                    // cb_func/cb_info before going into the wait loop
+                    if (parm.threads > 1) {
+                        ctx.ret = ParallelMip(lp->handle, &parm, &lp->cancel_).Solve();
+                        return;
+                    }
+                    // the search only yields for the reasons in parm.cb_reasons; of those, cbFunc blocks the
+                    // solver for cb_reasons only, the plug-ins and the progress stream never do
                     glp_intopt_start(lp->handle, &ctx);
-                    while(!ctx.done && parm.cb_func && parm.cb_info) {
-                        CallParmCBFromWorker();
+                    while(!ctx.done && ctx.tree) {
+                        if (plugins) plugins->Run(ctx.tree);
+                        if (progress) PushProgress(ctx.tree);
+                        if ((1 << glp_ios_reason(ctx.tree)) & cb_reasons) CallParmCBFromWorker();
                         // parm_cb is done now, go ahead and run next iteration
                         glp_intopt_run(&ctx);
                     }
                     // Call the callback when done. The intopt is done, so this would be a good place to grab the final
                     // mipGap from the tree on this LP or similar.
+                    if (progress && ctx.tree) PushProgress(ctx.tree);
                     CallParmCBFromWorker();
                     glp_intopt_stop(lp->handle, &ctx);
                 } catch (std::string s){
@@ -907,6 +1480,8 @@ namespace NodeGLPK {
             }
             
             virtual void HandleOKCallback() override {
+                // the last reports may still be queued
+                if (progress) DrainProgress();
                 if(callback) {
                     Local<Value> info[] = {Nan::Null(), Nan::New<Int32>(ctx.ret)};
                     callback->Call(2, info);
@@ -917,8 +1492,61 @@ namespace NodeGLPK {
                 // NOTABUG: Nan uses reinterpret_cast to pass uv_async_t around
                 uv_close(reinterpret_cast<uv_handle_t*>(parm_cb_async_.get()), IntoptWorker::ParmAsyncClose);
             }
+
+            // makes the search yield for the plug-ins and the progress stream when there is no cbFunc
+            static void YieldHook(glp_tree*, void*) {}
            
         private:
+            void PushProgress(glp_tree* T) {
+                ProgressReport report;
+                glp_prob* mip = glp_ios_get_prob(T);
+                int best = glp_ios_best_node(T);
+                report.reason = glp_ios_reason(T);
+                glp_ios_tree_size(T, &report.active, NULL, &report.nodes);
+                report.feasible = glp_mip_status(mip) == GLP_FEAS;
+                // no active node left: the search is over and the incumbent is optimal
+                report.bound = best ? glp_ios_node_bound(T, best) :
+                               report.feasible ? glp_mip_obj_val(mip) : glp_get_obj_val(mip);
+                report.incumbent = glp_mip_obj_val(mip);
+                report.gap = report.feasible ? glp_ios_mip_gap(T) : 0.0;
+                {
+                    std::lock_guard<std::mutex> guard{progress_lock_};
+                    if (progress_queue_.size() == kProgressQueue) {
+                        progress_queue_.pop_front();
+                        dropped_++;
+                    }
+                    progress_queue_.push_back(report);
+                }
+                uv_async_send(parm_cb_async_.get());
+            }
+
+            void DrainProgress() {
+                std::deque<ProgressReport> reports;
+                size_t dropped;
+                {
+                    std::lock_guard<std::mutex> guard{progress_lock_};
+                    reports.swap(progress_queue_);
+                    dropped = dropped_;
+                }
+                for (auto& report : reports) {
+                    Local<Object> p = Nan::New<Object>();
+                    p->Set(Nan::New<String>("reason").ToLocalChecked(), Nan::New<Int32>(report.reason));
+                    p->Set(Nan::New<String>("nodes").ToLocalChecked(), Nan::New<Int32>(report.nodes));
+                    p->Set(Nan::New<String>("active").ToLocalChecked(), Nan::New<Int32>(report.active));
+                    p->Set(Nan::New<String>("bound").ToLocalChecked(), Nan::New<Number>(report.bound));
+                    if (report.feasible) {
+                        p->Set(Nan::New<String>("incumbent").ToLocalChecked(), Nan::New<Number>(report.incumbent));
+                        p->Set(Nan::New<String>("gap").ToLocalChecked(), Nan::New<Number>(report.gap));
+                    } else {
+                        p->Set(Nan::New<String>("incumbent").ToLocalChecked(), Nan::Null());
+                        p->Set(Nan::New<String>("gap").ToLocalChecked(), Nan::Null());
+                    }
+                    p->Set(Nan::New<String>("dropped").ToLocalChecked(), Nan::New<Number>((double)dropped));
+                    Local<Value> argv[] = {p};
+                    progress->Call(1, argv);
+                }
+            }
+
             inline void CallParmCBFromWorker() {
                 if (!parm.cb_func || !parm.cb_info) {
                     return;
@@ -927,6 +1555,7 @@ namespace NodeGLPK {
 
                 // parm_cb has to be called on main loop thread, so we uv_async_send, and condwait for it.
                 parm_cb_done_ = false;
+                parm_cb_pending_ = true;
                 uv_async_send(parm_cb_async_.get());
 
                 while(!parm_cb_done_.load()) {
@@ -935,8 +1564,14 @@ namespace NodeGLPK {
             }
 
             void RunCallback() noexcept { 
-                std::lock_guard<std::mutex> guard{notify_lock_};
                 Nan::HandleScope scope;
+                // reports queued before a blocking callback are delivered first
+                if (progress) DrainProgress();
+
+                std::lock_guard<std::mutex> guard{notify_lock_};
+                // the async is shared with the progress stream, the solver may not be waiting
+                if (!parm_cb_pending_) return;
+                parm_cb_pending_ = false;
 
                 if (parm.cb_func && parm.cb_info) {
                     parm.cb_func(ctx.tree, parm.cb_info);
@@ -956,13 +1591,21 @@ namespace NodeGLPK {
             }
 
             std::atomic<bool> parm_cb_done_;
+            bool parm_cb_pending_;
             std::condition_variable notifier_;
             std::mutex notify_lock_;
             std::unique_ptr<uv_async_t> parm_cb_async_;
+            std::mutex progress_lock_;
+            std::deque<ProgressReport> progress_queue_;
+            size_t dropped_;
         public:
             Problem *lp;
             glp_iocp parm;
             glp_mip_ctx ctx;
+            // reasons for which cbFunc is called, parm.cb_reasons also has the plug-in and progress ones
+            int cb_reasons;
+            Nan::Callback* progress;
+            std::unique_ptr<MipPluginChain> plugins;
         };
         
         static NAN_METHOD(Intopt) {
@@ -973,15 +1616,635 @@ namespace NodeGLPK {
             V8CHECK(!lp->handle, "object deleted");
             V8CHECK(lp->thread.load(), "an async operation is inprogress");
             
+            lp->cancel_ = 0;
+            if (info[0]->IsObject()) {
+                Local<Value> race = info[0]->ToObject()->Get(Nan::New<String>("race").ToLocalChecked());
+                if (!race->IsUndefined()) {
+                    IntoptRace(lp, info[0], race, info[1].As<Function>());
+                    return;
+                }
+            }
             Nan::Callback *callback = new Nan::Callback(info[1].As<Function>());
             IntoptWorker *worker = new IntoptWorker(callback, lp);
-            if (!IocpInit(lp, &worker->parm, info[0])){
+            Local<Value> progress = Nan::Undefined();
+            if (!IocpInit(lp, &worker->parm, info[0], &progress, &worker->plugins)){
                 worker->Destroy();
                 return;
             }
+            // cbFunc blocks the search for the reasons asked for, the plug-ins need the search to yield
+            // for theirs, the progress stream at every selection and new incumbent
+            worker->cb_reasons = worker->parm.cb_info ? worker->parm.cb_reasons : 0;
+            if (!worker->parm.cb_info) worker->parm.cb_reasons = 0;
+            if (worker->plugins) worker->parm.cb_reasons |= worker->plugins->Reasons();
+            if (progress->IsFunction()) {
+                worker->progress = new Nan::Callback(Local<Function>::Cast(progress));
+                worker->parm.cb_reasons |= GLP_FSELECT | GLP_FBINGO;
+            }
+            if (!worker->parm.cb_func && worker->parm.cb_reasons) worker->parm.cb_func = IntoptWorker::YieldHook;
             lp->thread = true;
             GLPKEnvStateDecorator* decorated = new GLPKEnvStateDecorator(worker, lp->emitter_, lp->env_state_);
-            Nan::AsyncQueueWorker(decorated);
+            QueueWorker(decorated);
+        }
+
+        class IntoptRaceWorker : public Nan::AsyncWorker {
+        public:
+            IntoptRaceWorker(Nan::Callback *callback, Problem *lp)
+            : Nan::AsyncWorker(callback), lp(lp), ret(0), winner(-1){
+                GLP_CREATE_HOOK_GUARDS(lp);
+            }
+            void WorkComplete() {
+                lp->thread = false;
+                Nan::AsyncWorker::WorkComplete();
+            }
+            void Execute () {
+                try {
+                    MipRace race(lp->handle, configs, &lp->cancel_);
+                    ret = race.Solve();
+                    winner = race.Winner();
+                    rets = race.Rets();
+                    injected = race.Injected();
+                } catch (std::string s){
+                    SetErrorMessage(s.c_str());
+                }
+            }
+            void HandleOKCallback() {
+                Local<Object> result = Nan::New<Object>();
+                result->Set(Nan::New<String>("ret").ToLocalChecked(), Nan::New<Int32>(ret));
+                if (winner < 0)
+                    result->Set(Nan::New<String>("winner").ToLocalChecked(), Nan::Null());
+                else
+                    result->Set(Nan::New<String>("winner").ToLocalChecked(), Nan::New<Int32>(winner));
+                Local<Array> r = Nan::New<Array>(rets.size()), s = Nan::New<Array>(injected.size());
+                for (size_t k = 0; k < rets.size(); k++) r->Set(k, Nan::New<Int32>(rets[k]));
+                for (size_t k = 0; k < injected.size(); k++) s->Set(k, Nan::New<Int32>(injected[k]));
+                result->Set(Nan::New<String>("rets").ToLocalChecked(), r);
+                result->Set(Nan::New<String>("injected").ToLocalChecked(), s);
+                Local<Value> info[] = {Nan::Null(), result};
+                callback->Call(2, info);
+            }
+
+        public:
+            Problem *lp;
+            std::vector<glp_iocp> configs;
+            int ret, winner;
+            std::vector<int> rets, injected;
+        };
+
+        // intopt({race: [opts, ...], ...}, callback): runs glp_intopt once per entry of race, each with
+        // the other options overridden by the entry, on copies of the problem; see MipRace. The
+        // callback gets {ret, winner, rets, injected}, winner being the index of the entry which
+        // completed its search first, or null
+        static void IntoptRace(Problem* lp, Local<Value> opts, Local<Value> race, Local<Function> cb) {
+            V8CHECK(!race->IsArray() || Local<Array>::Cast(race)->Length() == 0, "race: should be a non-empty array of options");
+            Local<Array> entries = Local<Array>::Cast(race);
+            IntoptRaceWorker *worker = new IntoptRaceWorker(new Nan::Callback(cb), lp);
+            bool ok = true;
+            for (uint32_t k = 0; ok && k < entries->Length(); k++) {
+                glp_iocp parm;
+                glp_init_iocp(&parm);
+                Local<Value> progress = Nan::Undefined(), ignored;
+                std::unique_ptr<MipPluginChain> plugins;
+                ok = IocpInit(lp, &parm, opts, &progress, &plugins, &ignored);
+                // the runs only take search parameters; cbFunc and saveSol are refused in the base
+                // options before the entry is read, which would overwrite what they allocate
+                bool shared = parm.cb_info || parm.save_sol;
+                if (ok && !shared) {
+                    ok = IocpInit(lp, &parm, entries->Get(k), &progress, &plugins);
+                    shared = parm.cb_info || parm.save_sol || plugins || !progress->IsUndefined() || parm.threads > 1;
+                }
+                if (parm.cb_info) delete static_cast<IocpCallbackInfo*>(parm.cb_info);
+                if (parm.save_sol) delete[] parm.save_sol;
+                parm.cb_info = NULL;
+                parm.save_sol = NULL;
+                if (ok && shared) {
+                    Nan::ThrowTypeError("race: cbFunc, cbProgress, plugins, saveSol and threads are not available in a race");
+                    ok = false;
+                }
+                worker->configs.push_back(parm);
+            }
+            if (!ok) {
+                worker->Destroy();
+                return;
+            }
+            lp->thread = true;
+            GLPKEnvStateDecorator* decorated = new GLPKEnvStateDecorator(worker, lp->emitter_, lp->env_state_);
+            QueueWorker(decorated);
+        }
+
+        // a branch-and-bound search stepped by the MipScheduler: the search yields at every subproblem
+        // selection, where it can be left and resumed later, possibly on another thread
+        class ScheduledIntoptJob : public ScheduledJob {
+        public:
+            ScheduledIntoptJob(Nan::Callback *callback, Problem *lp, int priority, int64_t deadline)
+            : ScheduledJob(callback, lp, priority, deadline), started(false), steps(0),
+              nodes(0), active(0), bound(0.0), incumbent(0.0), gap(0.0), feasible(false){
+                GLP_CREATE_HOOK_GUARDS(lp);
+                glp_init_iocp(&parm);
+                glp_init_mip_ctx(&ctx);
+                ctx.parm = &parm;
+            }
+
+            ~ScheduledIntoptJob(){
+                if (parm.save_sol) delete[] parm.save_sol;
+            }
+
+            bool Step(int64_t until, int budget) {
+                auto info = std::make_shared<HookInfo>(nullptr, nullptr);
+                GLPKEnvStateGuard guard{lp->env_state_, info};
+                try {
+                    if (!started) {
+                        started = true;
+                        glp_intopt_start(lp->handle, &ctx);
+                        if (plugins && !Finished()) plugins->Run(ctx.tree);
+                    } else {
+                        // only the subproblem selections count, the other yields are for the plug-ins
+                        for (int k = 0; !Finished(); ) {
+                            if ((budget > 0 && k >= budget) || (until && k > 0 && MipScheduler::Now() >= until)) break;
+                            if (lp->cancel_ || (deadline && MipScheduler::Now() >= deadline)) glp_ios_terminate(ctx.tree);
+                            glp_intopt_run(&ctx);
+                            if (Finished()) break;
+                            if (plugins) plugins->Run(ctx.tree);
+                            if (glp_ios_reason(ctx.tree) == GLP_ISELECT) {
+                                k++;
+                                steps++;
+                            }
+                        }
+                    }
+                    if (Finished()) {
+                        glp_intopt_stop(lp->handle, &ctx);
+                        return true;
+                    }
+                    Snapshot();
+                } catch (std::string s){
+                    SetErrorMessage(s.c_str());
+                    return true;
+                }
+                return false;
+            }
+
+            void Progress() {
+                if (!progress) return;
+                Local<Object> result = Nan::New<Object>();
+                {
+                    std::lock_guard<std::mutex> lock(snapshot_lock);
+                    result->Set(Nan::New<String>("nodes").ToLocalChecked(), Nan::New<Int32>(nodes));
+                    result->Set(Nan::New<String>("active").ToLocalChecked(), Nan::New<Int32>(active));
+                    result->Set(Nan::New<String>("steps").ToLocalChecked(), Nan::New<Number>((double)steps));
+                    result->Set(Nan::New<String>("bound").ToLocalChecked(), Nan::New<Number>(bound));
+                    if (feasible) {
+                        result->Set(Nan::New<String>("incumbent").ToLocalChecked(), Nan::New<Number>(incumbent));
+                        result->Set(Nan::New<String>("gap").ToLocalChecked(), Nan::New<Number>(gap));
+                    } else {
+                        result->Set(Nan::New<String>("incumbent").ToLocalChecked(), Nan::Null());
+                        result->Set(Nan::New<String>("gap").ToLocalChecked(), Nan::Null());
+                    }
+                }
+                Local<Value> info[] = {result};
+                progress->Call(1, info);
+            }
+
+            void HandleOKCallback() {
+                Local<Value> info[] = {Nan::Null(), Nan::New<Int32>(ctx.ret)};
+                callback->Call(2, info);
+            }
+
+            // makes glp_intopt_run return at the next subproblem selection, or plug-in reason
+            static void Yield(glp_tree*, void*) {}
+
+        private:
+            bool Finished() const { return ctx.done || ctx.tree == NULL; }
+
+            void Snapshot() {
+                glp_tree* T = ctx.tree;
+                glp_prob* mip = glp_ios_get_prob(T);
+                int a_cnt, t_cnt;
+                glp_ios_tree_size(T, &a_cnt, NULL, &t_cnt);
+                int best = glp_ios_best_node(T);
+                std::lock_guard<std::mutex> lock(snapshot_lock);
+                nodes = t_cnt;
+                active = a_cnt;
+                bound = best ? glp_ios_node_bound(T, best) : glp_get_obj_val(mip);
+                feasible = glp_mip_status(mip) == GLP_FEAS;
+                incumbent = glp_mip_obj_val(mip);
+                gap = feasible ? glp_ios_mip_gap(T) : 0.0;
+            }
+
+            std::mutex snapshot_lock;
+        public:
+            glp_iocp parm;
+            glp_mip_ctx ctx;
+            bool started;
+            uint64_t steps;
+            int nodes, active;
+            double bound, incumbent, gap;
+            bool feasible;
+            std::unique_ptr<MipPluginChain> plugins;
+        };
+
+        // scheduleIntopt(iocp, {priority, deadline, progress}, callback): runs glp_intopt in slices on the
+        // MipScheduler threads; deadline is in milliseconds from now, the search is stopped with ESTOP
+        // when it is reached. pause() and resume() hold and release the job, cancel() stops it.
+        static NAN_METHOD(ScheduleIntopt) {
+            V8CHECK(info.Length() != 3, "Wrong number of arguments");
+            V8CHECK(!(info[0]->IsObject() || info[0]->IsNull()) || !(info[1]->IsObject() || info[1]->IsNull())
+                    || !info[2]->IsFunction(), "Wrong arguments");
+
+            Problem* lp = ObjectWrap::Unwrap<Problem>(info.Holder());
+            V8CHECK(!lp->handle, "object deleted");
+            V8CHECK(lp->thread.load(), "an async operation is inprogress");
+
+            int priority;
+            int64_t deadline;
+            Local<Value> progress;
+            if (!ScheduleOptsInit(info[1], &priority, &deadline, &progress)) return;
+
+            Nan::Callback *callback = new Nan::Callback(info[2].As<Function>());
+            ScheduledIntoptJob *job = new ScheduledIntoptJob(callback, lp, priority, deadline);
+            bool ok = IocpInit(lp, &job->parm, info[0], NULL, &job->plugins);
+            if (job->parm.cb_info) {
+                // the search is left at every selection, the callback would never see a live tree
+                delete static_cast<IocpCallbackInfo*>(job->parm.cb_info);
+                job->parm.cb_info = NULL;
+                if (ok) Nan::ThrowTypeError("cbFunc: not available in a scheduled job");
+                ok = false;
+            }
+            if (ok && job->parm.threads > 1) {
+                Nan::ThrowTypeError("threads: not available in a scheduled job");
+                ok = false;
+            }
+            if (!ok) {
+                job->Destroy();
+                return;
+            }
+            job->parm.cb_func = ScheduledIntoptJob::Yield;
+            job->parm.cb_reasons = GLP_FSELECT | (job->plugins ? job->plugins->Reasons() : 0);
+            Schedule(job, progress, info.Holder());
+        }
+
+        static NAN_METHOD(Pause) {
+            V8CHECK(info.Length() != 0, "Wrong number of arguments");
+
+            Problem* lp = ObjectWrap::Unwrap<Problem>(info.Holder());
+            info.GetReturnValue().Set(lp->job_ != NULL && MipScheduler::Instance().Pause(lp->job_));
+        }
+
+        static NAN_METHOD(Resume) {
+            V8CHECK(info.Length() != 0, "Wrong number of arguments");
+
+            Problem* lp = ObjectWrap::Unwrap<Problem>(info.Holder());
+            info.GetReturnValue().Set(lp->job_ != NULL && MipScheduler::Instance().Resume(lp->job_));
+        }
+
+        static bool NewQueuedOp(Problem* lp, const Nan::FunctionCallbackInfo<Value>& info, QueuedOp** op) {
+            std::string name = V8TOCSTRING(info[0]);
+            int argc = info.Length() - 1;
+
+            if (name == "setObjDir") {
+                V8CHECKBOOL(argc != 1, "Wrong number of arguments");
+                V8CHECKBOOL(!info[1]->IsInt32(), "Wrong arguments");
+                *op = new QueuedObjDir(info[1]->Int32Value());
+            } else if (name == "setRowBnds" || name == "setColBnds") {
+                V8CHECKBOOL(argc != 4, "Wrong number of arguments");
+                V8CHECKBOOL(!info[1]->IsInt32() || !info[2]->IsInt32()
+                            || !info[3]->IsNumber() || !info[4]->IsNumber(), "Wrong arguments");
+                *op = new QueuedBnds(name == "setRowBnds", info[1]->Int32Value(), info[2]->Int32Value(),
+                                     info[3]->NumberValue(), info[4]->NumberValue());
+            } else if (name == "setObjCoef") {
+                V8CHECKBOOL(argc != 2, "Wrong number of arguments");
+                V8CHECKBOOL(!info[1]->IsInt32() || !info[2]->IsNumber(), "Wrong arguments");
+                *op = new QueuedObjCoef(info[1]->Int32Value(), info[2]->NumberValue());
+            } else if (name == "setColKind") {
+                V8CHECKBOOL(argc != 2, "Wrong number of arguments");
+                V8CHECKBOOL(!info[1]->IsInt32() || !info[2]->IsInt32(), "Wrong arguments");
+                *op = new QueuedColKind(info[1]->Int32Value(), info[2]->Int32Value());
+            } else if (name == "setMatRow" || name == "setMatCol") {
+                V8CHECKBOOL(argc != 3, "Wrong number of arguments");
+                V8CHECKBOOL(!info[1]->IsInt32() || !info[2]->IsInt32Array() || !info[3]->IsFloat64Array(), "Wrong arguments");
+                Nan::TypedArrayContents<int> ind(info[2]);
+                Nan::TypedArrayContents<double> val(info[3]);
+                V8CHECKBOOL(ind.length() != val.length(), "the arrays must have the same length");
+                V8CHECKBOOL(ind.length() < 1, "Invalid Array size");
+                *op = new QueuedMat(name == "setMatRow", info[1]->Int32Value(), *ind, *val, (int)ind.length() - 1);
+            } else if (name == "loadMatrix") {
+                V8CHECKBOOL(argc != 4, "Wrong number of arguments");
+                V8CHECKBOOL(!info[1]->IsInt32() || !info[2]->IsInt32Array()
+                            || !info[3]->IsInt32Array() || !info[4]->IsFloat64Array(), "Wrong arguments");
+                Nan::TypedArrayContents<int> ia(info[2]);
+                Nan::TypedArrayContents<int> ja(info[3]);
+                Nan::TypedArrayContents<double> ar(info[4]);
+                int ne = info[1]->Int32Value();
+                V8CHECKBOOL(ne < 0, "Invalid number of elements");
+                V8CHECKBOOL((ia.length() <= (size_t)ne) || (ja.length() <= (size_t)ne) || (ar.length() <= (size_t)ne),
+                            "Invalid arrays length");
+                *op = new QueuedLoadMatrix(ne, *ia, *ja, *ar);
+            } else if (name == "simplex" || name == "exact") {
+                V8CHECKBOOL(argc > 1, "Wrong number of arguments");
+                V8CHECKBOOL(argc == 1 && !(info[1]->IsObject() || info[1]->IsNull()), "Wrong arguments");
+                QueuedSimplex* simplex = new QueuedSimplex(name == "exact");
+                *op = simplex;
+                if (argc == 1 && info[1]->IsObject() && !SmcpInit(&simplex->smcp, info[1])) return false;
+            } else if (name == "interior") {
+                V8CHECKBOOL(argc > 1, "Wrong number of arguments");
+                QueuedInterior* interior = new QueuedInterior();
+                *op = interior;
+                if (argc == 1 && !IptcpInit(&interior->iptcp, info[1])) return false;
+            } else if (name == "intopt") {
+                V8CHECKBOOL(argc > 1, "Wrong number of arguments");
+                QueuedIntopt* intopt = new QueuedIntopt();
+                *op = intopt;
+                bool ok = argc == 0 || IocpInit(lp, &intopt->iocp, info[1]);
+                if (intopt->iocp.cb_info) {
+                    // the queue never returns to JS before the whole solve is done
+                    delete static_cast<IocpCallbackInfo*>(intopt->iocp.cb_info);
+                    intopt->iocp.cb_info = NULL;
+                    V8CHECKBOOL(ok, "cbFunc: not available in a queued intopt");
+                }
+                if (!ok) return false;
+            } else if (name == "getObjVal" || name == "mipObjVal" || name == "iptObjVal") {
+                V8CHECKBOOL(argc != 0, "Wrong number of arguments");
+                *op = new QueuedValue<double>(name == "getObjVal" ? glp_get_obj_val
+                                              : name == "mipObjVal" ? glp_mip_obj_val : glp_ipt_obj_val);
+            } else if (name == "getStatus" || name == "mipStatus" || name == "iptStatus") {
+                V8CHECKBOOL(argc != 0, "Wrong number of arguments");
+                *op = new QueuedValue<int>(name == "getStatus" ? glp_get_status
+                                           : name == "mipStatus" ? glp_mip_status : glp_ipt_status);
+            } else {
+                static const struct { const char* name; bool rows; double (*api)(glp_prob*, int); } arrays[] = {
+                    {"getRowPrimArray", true, glp_get_row_prim}, {"getRowDualArray", true, glp_get_row_dual},
+                    {"getColPrimArray", false, glp_get_col_prim}, {"getColDualArray", false, glp_get_col_dual},
+                    {"iptRowPrimArray", true, glp_ipt_row_prim}, {"iptRowDualArray", true, glp_ipt_row_dual},
+                    {"iptColPrimArray", false, glp_ipt_col_prim}, {"iptColDualArray", false, glp_ipt_col_dual},
+                    {"mipRowValArray", true, glp_mip_row_val}, {"mipColValArray", false, glp_mip_col_val}
+                };
+                for (size_t k = 0; k < sizeof(arrays) / sizeof(arrays[0]); k++) {
+                    if (name == arrays[k].name) {
+                        V8CHECKBOOL(argc != 0, "Wrong number of arguments");
+                        *op = new QueuedArray(arrays[k].rows, arrays[k].api);
+                        return true;
+                    }
+                }
+                std::string error("Unknown operation: ");
+                error += name;
+                V8CHECKBOOL(true, error.c_str());
+            }
+            return true;
+        }
+
+        class OperationQueueWorker : public Nan::AsyncWorker {
+        public:
+            explicit OperationQueueWorker(Problem *lp)
+            : Nan::AsyncWorker(NULL), lp(lp){}
+
+            // runs everything queued so far, including operations added while it is running
+            void Execute () {
+                for (;;) {
+                    QueuedOp* op;
+                    {
+                        std::lock_guard<std::mutex> lock(lp->queue_lock_);
+                        if (lp->queued_.empty()) break;
+                        op = lp->queued_.front();
+                        lp->queued_.pop_front();
+                    }
+                    try {
+                        op->error = op->Run(lp->handle);
+                    } catch (std::string s){
+                        op->error = s;
+                    }
+                    std::lock_guard<std::mutex> lock(lp->queue_lock_);
+                    lp->settled_.push_back(op);
+                }
+            }
+
+            void WorkComplete() {
+                lp->thread = false;
+                lp->queue_running_ = false;
+                Nan::AsyncWorker::WorkComplete();
+
+                // operations queued after Execute() returned, unless a promise reaction already restarted the queue
+                bool pending;
+                {
+                    std::lock_guard<std::mutex> lock(lp->queue_lock_);
+                    pending = !lp->queued_.empty();
+                }
+                if (pending && !lp->queue_running_) lp->RunQueue();
+            }
+
+            void HandleOKCallback() {
+                std::deque<QueuedOp*> settled;
+                {
+                    std::lock_guard<std::mutex> lock(lp->queue_lock_);
+                    settled.swap(lp->settled_);
+                }
+                for (auto op : settled) {
+                    op->Settle();
+                    delete op;
+                }
+            }
+        public:
+            Problem *lp;
+        };
+
+        void RunQueue() {
+            queue_running_ = true;
+            thread = true;
+            OperationQueueWorker* worker = new OperationQueueWorker(this);
+            worker->SaveToPersistent("problem", node::ObjectWrap::handle());
+            GLPKEnvStateDecorator* decorated = new GLPKEnvStateDecorator(worker, emitter_, env_state_);
+            QueueWorker(decorated);
+        }
+
+        // enqueue(name, ...args): queues a Problem method to run after the operations already queued and
+        // returns a promise for its result; queued operations run back-to-back on one worker
+        static NAN_METHOD(Enqueue) {
+            V8CHECK(info.Length() < 1, "Wrong number of arguments");
+            V8CHECK(!info[0]->IsString(), "Wrong arguments");
+
+            Problem* lp = ObjectWrap::Unwrap<Problem>(info.Holder());
+            V8CHECK(!lp->handle, "object deleted");
+            V8CHECK(lp->thread.load() && !lp->queue_running_, "an async operation is inprogress");
+
+            QueuedOp* op = NULL;
+            if (!NewQueuedOp(lp, info, &op)) {
+                delete op;
+                return;
+            }
+            Local<Value> promise = op->NewPromise();
+            {
+                std::lock_guard<std::mutex> lock(lp->queue_lock_);
+                lp->queued_.push_back(op);
+            }
+            if (!lp->queue_running_) lp->RunQueue();
+            info.GetReturnValue().Set(promise);
+        }
+
+        class SolveBatchWorker : public Nan::AsyncWorker {
+        public:
+            enum Method { SIMPLEX, EXACT, INTERIOR, INTOPT };
+
+            SolveBatchWorker(Nan::Callback *callback, const std::vector<Problem*>& problems)
+            : Nan::AsyncWorker(callback), problems(problems), method(SIMPLEX), concurrency(1),
+              ret(problems.size(), 0), status(problems.size(), 0), obj(problems.size(), 0.0){
+                glp_init_smcp(&smcp);
+                glp_init_iptcp(&iptcp);
+                glp_init_iocp(&iocp);
+            }
+
+            ~SolveBatchWorker(){
+                if (iocp.save_sol) delete[] iocp.save_sol;
+            }
+
+            void WorkComplete() {
+                for (auto lp : problems) lp->thread = false;
+                Nan::AsyncWorker::WorkComplete();
+            }
+
+            // each thread takes the next unsolved problem and keeps its GLPK environment across problems
+            void Execute () {
+                std::atomic<size_t> next{0};
+                auto run = [this, &next]() {
+                    auto info = std::make_shared<HookInfo>(nullptr, nullptr);
+                    for (size_t k = next++; k < problems.size(); k = next++) {
+                        Problem* lp = problems[k];
+                        GLPKEnvStateLease lease{lp->env_state_, info};
+                        try {
+                            Solve(k, lp->handle);
+                        } catch (std::string s){
+                            std::lock_guard<std::mutex> lock(error_lock);
+                            if (!ErrorMessage()) SetErrorMessage(s.c_str());
+                        }
+                    }
+                    glp_free_env();
+                };
+                std::vector<std::thread> threads;
+                for (int t = 1; t < concurrency; t++) threads.emplace_back(run);
+                run();
+                for (auto& t : threads) t.join();
+            }
+
+            void HandleOKCallback() {
+                Local<Object> result = Nan::New<Object>();
+                result->Set(Nan::New<String>("ret").ToLocalChecked(), ToArray<Int32Array, int>(ret));
+                result->Set(Nan::New<String>("status").ToLocalChecked(), ToArray<Int32Array, int>(status));
+                result->Set(Nan::New<String>("obj").ToLocalChecked(), ToArray<Float64Array, double>(obj));
+                Local<Value> info[] = {Nan::Null(), result};
+                callback->Call(2, info);
+            }
+
+        private:
+            void Solve(size_t k, glp_prob* P) {
+                switch (method) {
+                    case SIMPLEX:
+                    case EXACT:
+                        ret[k] = (method == SIMPLEX) ? glp_simplex(P, &smcp) : glp_exact(P, &smcp);
+                        status[k] = glp_get_status(P);
+                        obj[k] = glp_get_obj_val(P);
+                        break;
+                    case INTERIOR:
+                        ret[k] = glp_interior(P, &iptcp);
+                        status[k] = glp_ipt_status(P);
+                        obj[k] = glp_ipt_obj_val(P);
+                        break;
+                    case INTOPT:
+                        ret[k] = RunIntopt(P, &iocp);
+                        status[k] = glp_mip_status(P);
+                        obj[k] = glp_mip_obj_val(P);
+                        break;
+                }
+            }
+
+            template <typename A, typename T>
+            static Local<A> ToArray(const std::vector<T>& values) {
+                Local<A> array = A::New(ArrayBuffer::New(Isolate::GetCurrent(), sizeof(T) * values.size()), 0, values.size());
+                Nan::TypedArrayContents<T> dst(array);
+                if (!values.empty()) memcpy(*dst, values.data(), sizeof(T) * values.size());
+                return array;
+            }
+
+            std::mutex error_lock;
+        public:
+            std::vector<Problem*> problems;
+            Method method;
+            int concurrency;
+            std::vector<int> ret, status;
+            std::vector<double> obj;
+            glp_smcp smcp;
+            glp_iptcp iptcp;
+            glp_iocp iocp;
+        };
+
+        // solveBatch(problems, {method, opts, concurrency}, callback): solves independent problems in
+        // parallel as one job, the callback gets {ret, status, obj} arrays in the order of problems
+        static NAN_METHOD(SolveBatch) {
+            V8CHECK(info.Length() != 3, "Wrong number of arguments");
+            V8CHECK(!info[0]->IsArray() || !(info[1]->IsObject() || info[1]->IsNull())
+                    || !info[2]->IsFunction(), "Wrong arguments");
+
+            Local<Array> list = Local<Array>::Cast(info[0]);
+            Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(constructor);
+            std::vector<Problem*> problems;
+            std::set<Problem*> seen;
+            for (uint32_t i = 0; i < list->Length(); i++) {
+                Local<Value> item = list->Get(i);
+                V8CHECK(!tpl->HasInstance(item), "problems: should only contain Problem objects");
+                Problem* lp = ObjectWrap::Unwrap<Problem>(item->ToObject());
+                V8CHECK(!lp->handle, "object deleted");
+                V8CHECK(lp->thread.load(), "an async operation is inprogress");
+                V8CHECK(!seen.insert(lp).second, "problems: the same Problem is listed twice");
+                problems.push_back(lp);
+            }
+
+            std::string method = "simplex";
+            Local<Value> opts = Nan::Undefined();
+            int concurrency = (int)std::thread::hardware_concurrency();
+            if (info[1]->IsObject()) {
+                Local<Object> batch = info[1]->ToObject();
+                Local<Value> val = batch->Get(Nan::New<String>("method").ToLocalChecked());
+                if (!val->IsUndefined()) {
+                    V8CHECK(!val->IsString(), "method: should be a string");
+                    method = V8TOCSTRING(val);
+                }
+                val = batch->Get(Nan::New<String>("concurrency").ToLocalChecked());
+                if (!val->IsUndefined()) {
+                    V8CHECK(!val->IsInt32() || val->Int32Value() < 1, "concurrency: should be a positive int32");
+                    concurrency = val->Int32Value();
+                }
+                opts = batch->Get(Nan::New<String>("opts").ToLocalChecked());
+            }
+            if (concurrency < 1) concurrency = 1;
+            if ((size_t)concurrency > problems.size()) concurrency = (int)problems.size();
+
+            Nan::Callback *callback = new Nan::Callback(info[2].As<Function>());
+            SolveBatchWorker *worker = new SolveBatchWorker(callback, problems);
+            worker->concurrency = concurrency;
+            bool ok = true;
+            if (method == "simplex" || method == "exact") {
+                worker->method = (method == "simplex") ? SolveBatchWorker::SIMPLEX : SolveBatchWorker::EXACT;
+                if (opts->IsObject()) ok = SmcpInit(&worker->smcp, opts);
+            } else if (method == "interior") {
+                worker->method = SolveBatchWorker::INTERIOR;
+                ok = IptcpInit(&worker->iptcp, opts);
+            } else if (method == "intopt") {
+                worker->method = SolveBatchWorker::INTOPT;
+                ok = problems.empty() || IocpInit(problems[0], &worker->iocp, opts);
+                if (worker->iocp.cb_info) {
+                    delete static_cast<IocpCallbackInfo*>(worker->iocp.cb_info);
+                    worker->iocp.cb_info = NULL;
+                    worker->iocp.cb_func = NULL;
+                    if (ok) Nan::ThrowTypeError("cbFunc: not available in a batch");
+                    ok = false;
+                }
+            } else {
+                Nan::ThrowTypeError("method: should be 'simplex', 'exact', 'interior' or 'intopt'");
+                ok = false;
+            }
+            if (!ok) {
+                worker->Destroy();
+                return;
+            }
+
+            for (auto lp : problems) lp->thread = true;
+            worker->SaveToPersistent("problems", info[0]);
+            QueueWorker(worker);
         }
         
         static NAN_METHOD(ReadLpSync) {
@@ -1036,7 +2299,7 @@ namespace NodeGLPK {
             ReadLpWorker *worker = new ReadLpWorker(callback, lp, V8TOCSTRING(info[0]));
             lp->thread = true;
             GLPKEnvStateDecorator* decorated = new GLPKEnvStateDecorator(worker, lp->emitter_, lp->env_state_);
-            Nan::AsyncQueueWorker(decorated);
+            QueueWorker(decorated);
         }
         
         static NAN_METHOD(WriteLpSync) {
@@ -1090,7 +2353,7 @@ namespace NodeGLPK {
             WriteLpWorker *worker = new WriteLpWorker(callback, lp, V8TOCSTRING(info[0]));
             lp->thread = true;
             GLPKEnvStateDecorator* decorated = new GLPKEnvStateDecorator(worker, lp->emitter_, lp->env_state_);
-            Nan::AsyncQueueWorker(decorated);
+            QueueWorker(decorated);
         }
         
         static NAN_METHOD(CheckKkt) {
@@ -1211,7 +2474,7 @@ namespace NodeGLPK {
             
             lp->thread = true;
             GLPKEnvStateDecorator* decorated = new GLPKEnvStateDecorator(worker, lp->emitter_, lp->env_state_);
-            Nan::AsyncQueueWorker(decorated);
+            QueueWorker(decorated);
         }
         
         static NAN_METHOD(GetBfcp) {
@@ -1322,7 +2585,7 @@ namespace NodeGLPK {
             ScaleWorker *worker = new ScaleWorker(callback, lp, info[0]->Int32Value());
             lp->thread = true;
             GLPKEnvStateDecorator* decorated = new GLPKEnvStateDecorator(worker, lp->emitter_, lp->env_state_);
-            Nan::AsyncQueueWorker(decorated);
+            QueueWorker(decorated);
         }
         
 
@@ -1363,7 +2626,7 @@ namespace NodeGLPK {
             FactorizeWorker *worker = new FactorizeWorker(callback, lp);
             lp->thread = true;
             GLPKEnvStateDecorator* decorated = new GLPKEnvStateDecorator(worker, lp->emitter_, lp->env_state_);
-            Nan::AsyncQueueWorker(decorated);
+            QueueWorker(decorated);
         }
         
         
@@ -1384,6 +2647,9 @@ namespace NodeGLPK {
         
         GLP_BIND_VOID_INT32_INT32_DOUBLE_DOUBLE(Problem, SetRowBnds, glp_set_row_bnds);
         
+        GLP_BIND_VOID_INT32ARRAY_INT32ARRAY_FLOAT64ARRAY_FLOAT64ARRAY(Problem, SetRowBndsArray, glp_get_num_rows, 1,
+            glp_set_row_bnds, GLP_FR, GLP_FX);
+        
         GLP_BIND_VOID_INT32(Problem, AddCols, glp_add_cols);
         
         GLP_BIND_VOID_INT32_STR(Problem, SetColName, glp_set_col_name);
@@ -1392,8 +2658,13 @@ namespace NodeGLPK {
         
         GLP_BIND_VOID_INT32_INT32_DOUBLE_DOUBLE(Problem, SetColBnds, glp_set_col_bnds);
         
+        GLP_BIND_VOID_INT32ARRAY_INT32ARRAY_FLOAT64ARRAY_FLOAT64ARRAY(Problem, SetColBndsArray, glp_get_num_cols, 1,
+            glp_set_col_bnds, GLP_FR, GLP_FX);
+        
         GLP_BIND_VOID_INT32_DOUBLE(Problem, SetObjCoef, glp_set_obj_coef);
         
+        GLP_BIND_VOID_INT32ARRAY_FLOAT64ARRAY(Problem, SetObjCoefArray, glp_get_num_cols, 0, glp_set_obj_coef);
+        
         GLP_BIND_VALUE_INT32(Problem, GetObjCoef, glp_get_obj_coef);
         
         GLP_BIND_VALUE(Problem, GetObjVal, glp_get_obj_val);
@@ -1410,6 +2681,57 @@ namespace NodeGLPK {
         
         GLP_BIND_VALUE_INT32_CALLBACK(Problem, GetMatCol, glp_get_mat_col);
         
+        // getMatrix([{format: 'csr' | 'csc'}]) returns {format, start, index, value} laid out like the
+        // fromDescriptor matrix; each row (column) list is copied straight into the typed arrays
+        static NAN_METHOD(GetMatrix) {
+            V8CHECK(info.Length() > 1, "Wrong number of arguments");
+            V8CHECK(info.Length() == 1 && !(info[0]->IsObject() || info[0]->IsUndefined()), "Wrong arguments");
+
+            bool csc = false;
+            if (info.Length() == 1 && info[0]->IsObject()) {
+                Local<Value> fmt = info[0]->ToObject()->Get(Nan::New<String>("format").ToLocalChecked());
+                if (!fmt->IsUndefined()) {
+                    V8CHECK(!fmt->IsString(), "format: should be a string");
+                    std::string f = V8TOCSTRING(fmt);
+                    V8CHECK(f != "csr" && f != "csc", "format: should be 'csr' or 'csc'");
+                    csc = (f == "csc");
+                }
+            }
+
+            Problem* lp = ObjectWrap::Unwrap<Problem>(info.Holder());
+            V8CHECK(!lp->handle, "object deleted");
+            V8CHECK(lp->thread.load(), "an async operation is inprogress");
+
+            GLP_CREATE_HOOK_GUARDS(lp);
+            GLP_CATCH_RET(
+                int major = csc ? glp_get_num_cols(lp->handle) : glp_get_num_rows(lp->handle);
+                int nnz = glp_get_num_nz(lp->handle);
+                Isolate* isolate = Isolate::GetCurrent();
+                Local<Int32Array> start = Int32Array::New(ArrayBuffer::New(isolate, sizeof(int) * (major + 2)), 0, major + 2);
+                Local<Int32Array> index = Int32Array::New(ArrayBuffer::New(isolate, sizeof(int) * (nnz + 1)), 0, nnz + 1);
+                Local<Float64Array> value = Float64Array::New(ArrayBuffer::New(isolate, sizeof(double) * (nnz + 1)), 0, nnz + 1);
+                Nan::TypedArrayContents<int> pstart(start);
+                Nan::TypedArrayContents<int> pindex(index);
+                Nan::TypedArrayContents<double> pvalue(value);
+
+                // glp_get_mat_row/col fill ind[1..len], so each list lands at start[k] - 1
+                (*pstart)[1] = 1;
+                for (int k = 1; k <= major; k++) {
+                    int pos = (*pstart)[k];
+                    int len = csc ? glp_get_mat_col(lp->handle, k, *pindex + pos - 1, *pvalue + pos - 1)
+                                  : glp_get_mat_row(lp->handle, k, *pindex + pos - 1, *pvalue + pos - 1);
+                    (*pstart)[k + 1] = pos + len;
+                }
+
+                Local<Object> ret = Nan::New<Object>();
+                ret->Set(Nan::New<String>("format").ToLocalChecked(), Nan::New<String>(csc ? "csc" : "csr").ToLocalChecked());
+                ret->Set(Nan::New<String>("start").ToLocalChecked(), start);
+                ret->Set(Nan::New<String>("index").ToLocalChecked(), index);
+                ret->Set(Nan::New<String>("value").ToLocalChecked(), value);
+                info.GetReturnValue().Set(ret);
+            )
+        }
+        
         GLP_BIND_VOID(Problem, SortMatrix, glp_sort_matrix);
         
         GLP_BIND_VOID_INT32ARRAY(Problem, DelRows, glp_del_rows);
@@ -1463,8 +2785,12 @@ namespace NodeGLPK {
         
         GLP_BIND_VALUE_INT32(Problem, GetRowStat, glp_get_row_stat);
         
+        GLP_BIND_INT32ARRAY(Problem, GetRowStatArray, glp_get_num_rows, glp_get_row_stat);
+        
         GLP_BIND_VALUE_INT32(Problem, GetColStat, glp_get_col_stat);
         
+        GLP_BIND_INT32ARRAY(Problem, GetColStatArray, glp_get_num_cols, glp_get_col_stat);
+        
         GLP_BIND_VOID(Problem, StdBasis, glp_std_basis);
         
         GLP_BIND_VOID_INT32(Problem, AdvBasis, glp_adv_basis);
@@ -1479,12 +2805,20 @@ namespace NodeGLPK {
         
         GLP_BIND_VALUE_INT32(Problem, GetRowPrim, glp_get_row_prim);
         
+        GLP_BIND_FLOAT64ARRAY(Problem, GetRowPrimArray, glp_get_num_rows, glp_get_row_prim);
+        
         GLP_BIND_VALUE_INT32(Problem, GetRowDual, glp_get_row_dual);
         
+        GLP_BIND_FLOAT64ARRAY(Problem, GetRowDualArray, glp_get_num_rows, glp_get_row_dual);
+        
         GLP_BIND_VALUE_INT32(Problem, GetColPrim, glp_get_col_prim);
         
+        GLP_BIND_FLOAT64ARRAY(Problem, GetColPrimArray, glp_get_num_cols, glp_get_col_prim);
+        
         GLP_BIND_VALUE_INT32(Problem, GetColDual, glp_get_col_dual);
         
+        GLP_BIND_FLOAT64ARRAY(Problem, GetColDualArray, glp_get_num_cols, glp_get_col_dual);
+        
         GLP_BIND_VALUE(Problem, GetUnbndRay, glp_get_unbnd_ray);
         
         GLP_BIND_VALUE(Problem, GetItCnt, glp_get_it_cnt);
@@ -1497,14 +2831,24 @@ namespace NodeGLPK {
         
         GLP_BIND_VALUE_INT32(Problem, IptRowPrim, glp_ipt_row_prim);
         
+        GLP_BIND_FLOAT64ARRAY(Problem, IptRowPrimArray, glp_get_num_rows, glp_ipt_row_prim);
+        
         GLP_BIND_VALUE_INT32(Problem, IptRowDual, glp_ipt_row_dual);
         
+        GLP_BIND_FLOAT64ARRAY(Problem, IptRowDualArray, glp_get_num_rows, glp_ipt_row_dual);
+        
         GLP_BIND_VALUE_INT32(Problem, IptColPrim, glp_ipt_col_prim);
         
+        GLP_BIND_FLOAT64ARRAY(Problem, IptColPrimArray, glp_get_num_cols, glp_ipt_col_prim);
+        
         GLP_BIND_VALUE_INT32(Problem, IptColDual, glp_ipt_col_dual);
         
+        GLP_BIND_FLOAT64ARRAY(Problem, IptColDualArray, glp_get_num_cols, glp_ipt_col_dual);
+        
         GLP_BIND_VOID_INT32_INT32(Problem, SetColKind, glp_set_col_kind);
         
+        GLP_BIND_VOID_INT32ARRAY_INT32ARRAY(Problem, SetColKindArray, glp_get_num_cols, 1, glp_set_col_kind, GLP_CV, GLP_BV);
+        
         GLP_BIND_VALUE_INT32(Problem, GetColKind, glp_get_col_kind);
         
         GLP_BIND_VALUE(Problem, GetNumInt, glp_get_num_int);
@@ -1523,8 +2867,12 @@ namespace NodeGLPK {
         
         GLP_BIND_VALUE_INT32(Problem, MipRowVal, glp_mip_row_val);
         
+        GLP_BIND_FLOAT64ARRAY(Problem, MipRowValArray, glp_get_num_rows, glp_mip_row_val);
+        
         GLP_BIND_VALUE_INT32(Problem, MipColVal, glp_mip_col_val);
         
+        GLP_BIND_FLOAT64ARRAY(Problem, MipColValArray, glp_get_num_cols, glp_mip_col_val);
+        
         GLP_BIND_VALUE_STR(Problem, PrintSolSync, glp_print_sol);
         GLP_ASYNC_INT32_STR(Problem, PrintSol, glp_print_sol);
         
@@ -1613,6 +2961,13 @@ namespace NodeGLPK {
         std::shared_ptr<HookInfo> info_;
         std::shared_ptr<glp_environ_state_t> env_state_;
         struct glp_memory_counters counters_;
+        std::deque<QueuedOp*> queued_, settled_;
+        std::mutex queue_lock_;
+        bool queue_running_;
+        // polled by the running simplex, exact or interior-point solve and scheduled search, see Cancel
+        volatile int cancel_;
+        // the scheduled simplex or branch-and-bound search in progress, see ScheduleSimplex and ScheduleIntopt
+        SlicedJob* job_;
     public:
         glp_prob *handle;
         std::atomic<bool> thread;
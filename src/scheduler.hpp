@@ -0,0 +1,262 @@
+#pragma once
+#ifndef _NODE_GLPK_SCHEDULER_HPP
+#define _NODE_GLPK_SCHEDULER_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <nan.h>
+#include <uv.h>
+
+namespace NodeGLPK {
+
+/// A resumable job for the MipScheduler. Step() runs one slice on a scheduler thread and must
+/// return once the budget is spent; Progress() runs on the main thread after slices, then
+/// WorkComplete() and Destroy() once Step() has reported the job finished.
+class SlicedJob : public Nan::AsyncWorker {
+ public:
+    enum State { READY, RUNNING, PAUSED, DONE };
+
+    SlicedJob(Nan::Callback* callback, int priority, int64_t deadline)
+        : Nan::AsyncWorker(callback), priority(priority), deadline(deadline), used(0), slices(0),
+          state(READY), pause_(false), progress_(false) {}
+
+    /// Scheduler thread. `until` is a steady clock time in nanoseconds, `nodes` the number of
+    /// steps allowed. Returns true when the job is finished.
+    virtual bool Step(int64_t until, int nodes) = 0;
+    virtual void Progress() {}
+
+    // the scheduler calls Step() instead
+    void Execute() {}
+
+    int priority;
+    int64_t deadline;  // steady clock nanoseconds, 0 for none
+    int64_t used;      // nanoseconds spent in Step()
+    uint64_t slices;
+    State state;
+
+ private:
+    friend class MipScheduler;
+    bool pause_, progress_;
+};
+
+/// Threads which multiplex many sliced jobs, e.g. branch-and-bound searches stepped through
+/// glp_intopt_run, so that a long job cannot hold a thread until it is finished. The next job
+/// is the one with the highest priority, then the earliest deadline, then the least time used.
+/// The scheduler starts with one thread per core the first time a job is submitted.
+class MipScheduler {
+ public:
+    struct Stats {
+        size_t threads, ready, running, paused;
+        uint64_t submitted, completed, slices;
+    };
+
+    static MipScheduler& Instance() {
+        static MipScheduler scheduler;
+        return scheduler;
+    }
+
+    /// Main thread only. Replaces the threads; jobs keep their state.
+    void Configure(size_t threads, double slice_ms, int slice_nodes) {
+        Stop();
+        slice_ns_ = (int64_t)(slice_ms * 1e6);
+        slice_nodes_ = slice_nodes;
+        if (!async_init_) {
+            uv_async_init(uv_default_loop(), &async_, OnAsync);
+            async_.data = this;
+            uv_unref(reinterpret_cast<uv_handle_t*>(&async_));
+            async_init_ = true;
+        }
+        stop_ = false;
+        for (size_t k = 0; k < threads; k++) threads_.emplace_back(&MipScheduler::Run, this);
+        cond_.notify_all();
+    }
+
+    /// Main thread only. True while a job has not completed.
+    bool Busy() const { return inflight_ != 0; }
+
+    /// Main thread only.
+    void Submit(SlicedJob* job) {
+        if (threads_.empty()) Configure(std::max(1u, std::thread::hardware_concurrency()), 50, 0);
+        if (inflight_++ == 0) uv_ref(reinterpret_cast<uv_handle_t*>(&async_));
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            submitted_++;
+            jobs_.push_back(job);
+        }
+        cond_.notify_one();
+    }
+
+    /// Main thread only. A running job is paused at the end of its slice. Returns false when the
+    /// job is finished or already paused.
+    bool Pause(SlicedJob* job) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (job->state == SlicedJob::READY) {
+            job->state = SlicedJob::PAUSED;
+            return true;
+        }
+        if (job->state == SlicedJob::RUNNING && !job->pause_) {
+            job->pause_ = true;
+            return true;
+        }
+        return false;
+    }
+
+    /// Main thread only. Returns false when the job is neither paused nor pausing.
+    bool Resume(SlicedJob* job) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (job->state == SlicedJob::RUNNING && job->pause_) {
+                job->pause_ = false;
+                return true;
+            }
+            if (job->state != SlicedJob::PAUSED) return false;
+            job->state = SlicedJob::READY;
+        }
+        cond_.notify_one();
+        return true;
+    }
+
+    Stats GetStats() {
+        Stats stats = {threads_.size(), 0, 0, 0, 0, 0, 0};
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto job : jobs_) {
+            if (job->state == SlicedJob::READY) stats.ready++;
+            else if (job->state == SlicedJob::RUNNING) stats.running++;
+            else if (job->state == SlicedJob::PAUSED) stats.paused++;
+        }
+        stats.submitted = submitted_;
+        stats.completed = completed_;
+        stats.slices = slices_;
+        return stats;
+    }
+
+    static int64_t Now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    ~MipScheduler() {
+        // the process is exiting, a slice may still be running: do not wait for it
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cond_.notify_all();
+        for (auto& t : threads_) t.detach();
+    }
+
+ private:
+    MipScheduler() : stop_(false), async_init_(false), inflight_(0), submitted_(0), completed_(0),
+                     slices_(0), slice_ns_(0), slice_nodes_(0) {}
+
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cond_.notify_all();
+        for (auto& t : threads_) t.join();
+        threads_.clear();
+    }
+
+    // called with mutex_ held
+    SlicedJob* Next() {
+        SlicedJob* best = NULL;
+        for (auto job : jobs_) {
+            if (job->state != SlicedJob::READY) continue;
+            if (!best || Before(job, best)) best = job;
+        }
+        return best;
+    }
+
+    static bool Before(const SlicedJob* a, const SlicedJob* b) {
+        if (a->priority != b->priority) return a->priority > b->priority;
+        if (a->deadline != b->deadline) {
+            if (!a->deadline || !b->deadline) return a->deadline != 0;
+            return a->deadline < b->deadline;
+        }
+        return a->used < b->used;
+    }
+
+    void Run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            SlicedJob* job;
+            cond_.wait(lock, [this, &job] { return stop_ || (job = Next()) != NULL; });
+            if (stop_) break;
+            job->state = SlicedJob::RUNNING;
+            int64_t until = slice_ns_ > 0 ? Now() + slice_ns_ : 0;
+            int nodes = slice_nodes_;
+            lock.unlock();
+
+            int64_t start = Now();
+            bool finished = job->Step(until, nodes);
+            int64_t spent = Now() - start;
+
+            lock.lock();
+            job->used += spent;
+            job->slices++;
+            slices_++;
+            if (finished) {
+                job->state = SlicedJob::DONE;
+                jobs_.remove(job);
+                done_.push_back(job);
+            } else {
+                job->state = job->pause_ ? SlicedJob::PAUSED : SlicedJob::READY;
+                job->pause_ = false;
+                if (job->state == SlicedJob::READY) cond_.notify_one();
+                if (!job->progress_) {
+                    job->progress_ = true;
+                    progress_.push_back(job);
+                }
+            }
+            uv_async_send(&async_);
+        }
+    }
+
+    // progress is reported before completion, a finished job is never in progress_ afterwards
+    static void OnAsync(uv_async_t* handle) {
+        MipScheduler* scheduler = static_cast<MipScheduler*>(handle->data);
+        std::deque<SlicedJob*> progress, done;
+        {
+            std::lock_guard<std::mutex> lock(scheduler->mutex_);
+            progress.swap(scheduler->progress_);
+            done.swap(scheduler->done_);
+            for (auto job : progress) job->progress_ = false;
+            scheduler->completed_ += done.size();
+        }
+        Nan::HandleScope scope;
+        for (auto job : progress) {
+            if (std::find(done.begin(), done.end(), job) == done.end()) job->Progress();
+        }
+        for (auto job : done) {
+            job->WorkComplete();
+            job->Destroy();
+        }
+        scheduler->inflight_ -= done.size();
+        if (scheduler->inflight_ == 0) uv_unref(reinterpret_cast<uv_handle_t*>(&scheduler->async_));
+    }
+
+    std::vector<std::thread> threads_;
+    std::list<SlicedJob*> jobs_;
+    std::deque<SlicedJob*> progress_, done_;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    bool stop_;
+    uv_async_t async_;
+    bool async_init_;
+    size_t inflight_;
+    uint64_t submitted_, completed_, slices_;
+    int64_t slice_ns_;
+    int slice_nodes_;
+};
+
+}  // namespace NodeGLPK
+#endif
@@ -0,0 +1,207 @@
+#pragma once
+#ifndef _NODE_GLPK_SOLVERPOOL_HPP
+#define _NODE_GLPK_SOLVERPOOL_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <nan.h>
+#include <uv.h>
+
+namespace NodeGLPK {
+
+/// Worker threads owned by the module for the async solver methods, so that long solves do
+/// not occupy libuv's threadpool, which is shared with fs, dns and zlib. The pool is off until
+/// configured; while it is off QueueWorker falls back to Nan::AsyncQueueWorker.
+///
+/// Jobs are Nan::AsyncWorkers and go through the same sequence as with uv_queue_work:
+/// Execute() on a pool thread, then WorkComplete() and Destroy() on the main thread.
+class SolverPool {
+ public:
+    struct Stats {
+        size_t threads, queued, active;
+        uint64_t submitted, completed;
+        double busy, uptime;  // milliseconds
+    };
+
+    static SolverPool& Instance() {
+        static SolverPool pool;
+        return pool;
+    }
+
+    /// Main thread only. Replaces the running threads by `threads` new ones (0 stops the pool).
+    /// Thread k is pinned to affinity[k % affinity.size()] where supported.
+    void Configure(size_t threads, const std::vector<int>& affinity) {
+        Stop();
+        if (threads == 0) return;
+        if (!async_init_) {
+            uv_async_init(uv_default_loop(), &async_, OnComplete);
+            async_.data = this;
+            uv_unref(reinterpret_cast<uv_handle_t*>(&async_));
+            async_init_ = true;
+        }
+        stop_ = false;
+        busy_ns_ = 0;
+        started_ = Now();
+        running_.reset(new std::atomic<int64_t>[threads]);
+        for (size_t k = 0; k < threads; k++) {
+            running_[k] = 0;
+            threads_.emplace_back(&SolverPool::Run, this, k);
+            if (!affinity.empty()) Pin(threads_.back(), affinity[k % affinity.size()]);
+        }
+    }
+
+    bool Enabled() const { return !threads_.empty(); }
+
+    /// Main thread only. True while a job is queued, running or waiting for its completion.
+    bool Busy() const { return inflight_ != 0; }
+
+    /// Main thread only.
+    void Queue(Nan::AsyncWorker* worker) {
+        if (inflight_++ == 0) uv_ref(reinterpret_cast<uv_handle_t*>(&async_));
+        submitted_++;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.push_back(worker);
+        }
+        cond_.notify_one();
+    }
+
+    Stats GetStats() {
+        Stats stats;
+        int64_t now = Now();
+        int64_t busy = busy_ns_;
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats.threads = threads_.size();
+        stats.queued = queue_.size();
+        stats.active = active_;
+        stats.submitted = submitted_;
+        stats.completed = completed_;
+        // count the jobs still running up to now
+        for (size_t k = 0; k < threads_.size(); k++) {
+            int64_t since = running_[k];
+            if (since) busy += now - since;
+        }
+        stats.busy = busy / 1e6;
+        stats.uptime = threads_.empty() ? 0 : (now - started_) / 1e6;
+        return stats;
+    }
+
+    ~SolverPool() {
+        // the process is exiting, a solve may still be running: do not wait for it
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cond_.notify_all();
+        for (auto& t : threads_) t.detach();
+    }
+
+ private:
+    SolverPool() : stop_(false), async_init_(false), inflight_(0), active_(0),
+                   submitted_(0), completed_(0), busy_ns_(0), started_(0) {}
+
+    static int64_t Now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static void Pin(std::thread& t, int cpu) {
+#ifdef __linux__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        pthread_setaffinity_np(t.native_handle(), sizeof(set), &set);
+#endif
+    }
+
+    // queued jobs are left to the old threads before they exit
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cond_.notify_all();
+        for (auto& t : threads_) t.join();
+        threads_.clear();
+    }
+
+    void Run(size_t id) {
+        for (;;) {
+            Nan::AsyncWorker* worker;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cond_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+                if (queue_.empty()) break;
+                worker = queue_.front();
+                queue_.pop_front();
+                active_++;
+                running_[id] = Now();
+            }
+
+            worker->Execute();
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                busy_ns_ += Now() - running_[id];
+                running_[id] = 0;
+                active_--;
+                done_.push_back(worker);
+            }
+            uv_async_send(&async_);
+        }
+    }
+
+    static void OnComplete(uv_async_t* handle) {
+        SolverPool* pool = static_cast<SolverPool*>(handle->data);
+        std::deque<Nan::AsyncWorker*> done;
+        {
+            std::lock_guard<std::mutex> lock(pool->mutex_);
+            done.swap(pool->done_);
+            pool->completed_ += done.size();
+        }
+        Nan::HandleScope scope;
+        for (auto worker : done) {
+            worker->WorkComplete();
+            worker->Destroy();
+        }
+        pool->inflight_ -= done.size();
+        if (pool->inflight_ == 0) uv_unref(reinterpret_cast<uv_handle_t*>(&pool->async_));
+    }
+
+    std::vector<std::thread> threads_;
+    std::deque<Nan::AsyncWorker*> queue_, done_;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    bool stop_;
+    uv_async_t async_;
+    bool async_init_;
+    size_t inflight_, active_;
+    uint64_t submitted_, completed_;
+    std::atomic<int64_t> busy_ns_;
+    int64_t started_;
+    std::unique_ptr<std::atomic<int64_t>[]> running_;
+};
+
+/// Queues an async GLPK job on the solver pool when it is configured, on libuv's pool otherwise.
+static inline void QueueWorker(Nan::AsyncWorker* worker) {
+    SolverPool& pool = SolverPool::Instance();
+    if (pool.Enabled())
+        pool.Queue(worker);
+    else
+        Nan::AsyncQueueWorker(worker);
+}
+
+}  // namespace NodeGLPK
+#endif
@@ -59,12 +59,26 @@ namespace NodeGLPK {
             host->thread = false;
             return ret;
         }
+
+        // points a Tree kept across callbacks at the current glp_tree, see Problem::IocpCallback
+        void Bind(glp_tree* tree) {
+            handle = tree;
+            thread = false;
+        }
+
+        // the glp_tree is only valid during the callback
+        void Release() {
+            thread = true;
+            handle = NULL;
+        }
     private:
+        // env_state_ is the one of the problem being solved, set by Instantiate
         Tree()
            : node::ObjectWrap(),
              emitter_(std::make_shared<NodeEvent::EventEmitter>()),
              info_{std::make_shared<HookInfo>(emitter_)},
-             env_state_(make_shared_environ_state(info_)) {}
+             handle(NULL),
+             thread(true) {}
         ~Tree(){};
         
         static NAN_METHOD(New) {
@@ -16,6 +16,51 @@ function nearly(n, magnitude) {
     return [ n - 1/magnitude, n + 1/magnitude ]
 }
 
+function setupKnapsack(size, seed, rows = 3) {
+    const random = () => (seed = (seed * 16807) % 2147483647) / 2147483647
+    let lp = new glp.Problem()
+    lp.setObjDir(glp.MAX)
+    lp.addRows(rows)
+    lp.addCols(size)
+    let ind = new Int32Array(size + 1)
+    let val = new Float64Array(size + 1)
+    for (let j = 1; j <= size; j++) {
+        ind[j] = j
+        lp.setColKind(j, glp.BV)
+        lp.setObjCoef(j, 1 + Math.floor(1000 * random()))
+    }
+    for (let i = 1; i <= rows; i++) {
+        for (let j = 1; j <= size; j++) val[j] = 1 + Math.floor(1000 * random())
+        lp.setMatRow(i, size, ind, val)
+        lp.setRowBnds(i, glp.UP, 0.0, 100.0 * size)
+    }
+    lp.simplexSync({ msgLev: glp.MSG_OFF })
+    return lp
+}
+
+// dense random LP, which takes long enough to be cancelled or paused
+// while it runs
+function setupDenseLP(size, seed) {
+    const random = () => (seed = (seed * 16807) % 2147483647) / 2147483647
+    let lp = new glp.Problem()
+    lp.setObjDir(glp.MAX)
+    lp.addRows(size)
+    lp.addCols(size)
+    let ind = new Int32Array(size + 1)
+    let val = new Float64Array(size + 1)
+    for (let j = 1; j <= size; j++) {
+        ind[j] = j
+        lp.setColBnds(j, glp.LO, 0.0, 0.0)
+        lp.setObjCoef(j, 1 + Math.floor(50 * random()))
+    }
+    for (let i = 1; i <= size; i++) {
+        for (let j = 1; j <= size; j++) val[j] = 1 + Math.floor(100 * random())
+        lp.setMatRow(i, size, ind, val)
+        lp.setRowBnds(i, glp.UP, 0.0, 1000 + Math.floor(1000 * random()))
+    }
+    return lp
+}
+
 describe("Simplex problem tests", function() {
     it('should get the correct answer', function(done) {
         this.timeout(10000)
@@ -34,6 +79,89 @@ describe("Simplex problem tests", function() {
             done()
         })
     });
+
+    it('should take the same path with and without the vectorised kernels', function() {
+        this.timeout(20000)
+        let runs = [glp.OFF, glp.ON].map(function(simd) {
+            return [glp.PRIMAL, glp.DUAL].map(function(meth) {
+                let lp = new glp.Problem()
+                lp.readMpsSync(glp.MPS_DECK, null, testRoot + '/examples/25fv47.mps')
+                expect(lp.simplexSync({ msgLev: glp.MSG_OFF, meth: meth, simd: simd })).to.equal(0)
+                let run = [lp.getItCnt(), lp.getObjVal()]
+                lp.delete()
+                return run
+            })
+        })
+        expect(runs[1]).to.equal(runs[0])
+        expect(runs[0][0][1]).to.be.within(...(nearly(5501.8458882867, 1e6)))
+    });
+
+    it('should reach the same optimum with partial pricing', function() {
+        this.timeout(20000)
+        for (let pricing of [glp.PT_STD, glp.PT_PSE]) {
+            let lp = new glp.Problem()
+            lp.readMpsSync(glp.MPS_DECK, null, testRoot + '/examples/25fv47.mps')
+            expect(lp.simplexSync({ msgLev: glp.MSG_OFF, meth: glp.PRIMAL, pricing: pricing, partLen: 100 })).to.equal(0)
+            expect(lp.getStatus()).to.equal(glp.OPT)
+            expect(lp.getObjVal()).to.be.within(...(nearly(5501.8458882867, 1e6)))
+            lp.delete()
+        }
+        // windows cut short at the last of the 400 non-basic columns
+        let expected = setupKnapsack(400, 11)
+        let z = expected.getObjVal()
+        expected.delete()
+        for (let partLen of [1, 7, 399, 401]) {
+            let lp = setupKnapsack(400, 11)
+            lp.stdBasis()
+            expect(lp.simplexSync({ msgLev: glp.MSG_OFF, meth: glp.PRIMAL, partLen: partLen })).to.equal(0)
+            expect(lp.getStatus()).to.equal(glp.OPT)
+            expect(lp.getObjVal()).to.be.within(...(nearly(z, 1e6)))
+            lp.delete()
+        }
+    });
+
+    it('should reach the same optimum with the long-step ratio test', function() {
+        this.timeout(20000)
+        for (let pricing of [glp.PT_STD, glp.PT_PSE]) {
+            let lp = new glp.Problem()
+            lp.readMpsSync(glp.MPS_DECK, null, testRoot + '/examples/25fv47.mps')
+            expect(lp.simplexSync({ msgLev: glp.MSG_OFF, meth: glp.DUAL, pricing: pricing, rTest: glp.RT_FLIP })).to.equal(0)
+            expect(lp.getStatus()).to.equal(glp.OPT)
+            expect(lp.getObjVal()).to.be.within(...(nearly(5501.8458882867, 1e6)))
+            lp.delete()
+        }
+        let expected = setupKnapsack(400, 11)
+        let z = expected.getObjVal()
+        expected.delete()
+        let lp = setupKnapsack(400, 11)
+        lp.stdBasis()
+        expect(lp.simplexSync({ msgLev: glp.MSG_OFF, meth: glp.DUAL, rTest: glp.RT_FLIP })).to.equal(0)
+        expect(lp.getStatus()).to.equal(glp.OPT)
+        expect(lp.getObjVal()).to.be.within(...(nearly(z, 1e6)))
+        lp.delete()
+    });
+
+    it('should reach the same optimum with sifting', function(done) {
+        this.timeout(20000)
+        let expected = setupKnapsack(400, 11)
+        let z = expected.getObjVal()
+        expected.delete()
+
+        let lp = setupKnapsack(400, 11)
+        lp.stdBasis()
+        expect(lp.simplexSync({ msgLev: glp.MSG_OFF, meth: glp.SIFTING })).to.equal(0)
+        expect(lp.getStatus()).to.equal(glp.OPT)
+        expect(lp.getObjVal()).to.be.within(...(nearly(z, 1e6)))
+        lp.stdBasis()
+        lp.simplex({ msgLev: glp.MSG_OFF, meth: glp.SIFTING }, function(err, ret) {
+            expect(err).to.be.null()
+            expect(ret).to.equal(0)
+            expect(lp.getStatus()).to.equal(glp.OPT)
+            expect(lp.getObjVal()).to.be.within(...(nearly(z, 1e6)))
+            lp.delete()
+            done()
+        })
+    });
 })
 
 describe("Exact problem tests", function() {
@@ -118,6 +246,208 @@ describe("Intopt problem tests", function() {
             })
         })
     });
+
+    it('should stream progress without a cbFunc', function(done) {
+        this.timeout(10000)
+        let lp = setupKnapsack(30, 7)
+        let reference = setupKnapsack(30, 7)
+        reference.intoptSync({ msgLev: glp.MSG_OFF })
+        let reports = []
+        lp.intopt({ msgLev: glp.MSG_OFF, cbProgress: function(p) { reports.push(p) } }, function(err, ret) {
+            expect(err).to.be.null()
+            expect(ret).to.equal(0)
+            expect(lp.mipObjVal()).to.equal(reference.mipObjVal())
+            expect(reports.length).to.be.above(1)
+            for (let k = 1; k < reports.length; k++)
+                expect(reports[k].nodes).to.be.at.least(reports[k - 1].nodes)
+            let last = reports[reports.length - 1]
+            expect(last.incumbent).to.equal(reference.mipObjVal())
+            expect(last.gap).to.be.a.number()
+            done()
+        })
+    });
+
+    it('should pass the same tree to every callback of a run', function() {
+        let lp = setupKnapsack(20, 3)
+        let trees = new Set()
+        let last = null
+        lp.intoptSync({
+            msgLev: glp.MSG_OFF,
+            cbFunc: function(tree) {
+                tree.reason()
+                trees.add(tree)
+                last = tree
+            }
+        })
+        expect(trees.size).to.equal(1)
+        expect(() => last.reason()).to.throw(TypeError, /object deleted/)
+    });
+
+    it('should run native plug-ins selected by name', function(done) {
+        this.timeout(10000)
+        let names = glp.mipPlugins().map(p => p.name)
+        expect(names).to.include(['objWeightedBranch', 'roundingHeur'])
+        let reference = setupKnapsack(30, 11)
+        reference.intoptSync({ msgLev: glp.MSG_OFF })
+        let sync = setupKnapsack(30, 11)
+        sync.intoptSync({ msgLev: glp.MSG_OFF, plugins: ['objWeightedBranch', 'roundingHeur'] })
+        expect(sync.mipObjVal()).to.equal(reference.mipObjVal())
+        expect(() => sync.intoptSync({ plugins: ['noSuchPlugin'] })).to.throw(TypeError, /noSuchPlugin/)
+
+        let lp = setupKnapsack(30, 11)
+        let branches = 0
+        lp.intopt({
+            msgLev: glp.MSG_OFF,
+            plugins: ['objWeightedBranch', 'roundingHeur'],
+            cbReasons: glp.FBRANCH,
+            cbFunc: function(tree) {
+                // the plug-in has branched already
+                if (tree.reason() == glp.IBRANCH) branches++
+            }
+        }, function(err, ret) {
+            expect(ret).to.equal(0)
+            expect(lp.mipObjVal()).to.equal(reference.mipObjVal())
+            expect(branches).to.be.above(0)
+            done()
+        })
+    });
+
+    it('should search on several threads', function(done) {
+        this.timeout(20000)
+        let reference = setupKnapsack(35, 5)
+        reference.intoptSync({ msgLev: glp.MSG_OFF })
+        let sync = setupKnapsack(35, 5)
+        sync.intoptSync({ msgLev: glp.MSG_OFF, threads: 4 })
+        expect(sync.mipStatus()).to.equal(glp.OPT)
+        expect(sync.mipObjVal()).to.equal(reference.mipObjVal())
+        expect(() => sync.intoptSync({ threads: 2, cbFunc: function() {} })).to.throw(TypeError, /threads/)
+        expect(() => sync.intoptSync({ threads: 0 })).to.throw(TypeError, /threads/)
+        expect(() => sync.intoptSync({ threads: 2, mirCuts: glp.ON })).to.throw(TypeError, /mirCuts/)
+        expect(() => sync.intoptSync({ threads: 2, fpHeur: glp.ON })).to.throw(TypeError, /fpHeur/)
+        expect(() => sync.intoptSync({ threads: 2, brTech: glp.BR_DTH })).to.throw(TypeError, /brTech/)
+        expect(() => sync.intoptSync({ threads: 2, btTech: glp.BT_DFS })).to.throw(TypeError, /btTech/)
+
+        let lp = setupKnapsack(35, 5)
+        lp.intopt({ msgLev: glp.MSG_OFF, threads: 3 }, function(err, ret) {
+            expect(ret).to.equal(0)
+            expect(lp.mipStatus()).to.equal(glp.OPT)
+            expect(lp.mipObjVal()).to.equal(reference.mipObjVal())
+            done()
+        })
+    });
+
+    it('should repeat the same deterministic parallel search', function() {
+        this.timeout(20000)
+        let solutions = []
+        for (let run = 0; run < 3; run++) {
+            let lp = setupKnapsack(35, 11)
+            let ret = lp.intoptSync({ msgLev: glp.MSG_OFF, threads: 4, parDet: glp.ON, parSeed: 7, brTech: glp.BR_MFV })
+            expect(ret).to.equal(0)
+            expect(lp.mipStatus()).to.equal(glp.OPT)
+            solutions.push(Array.from(lp.mipColValArray()))
+        }
+        expect(solutions[1]).to.equal(solutions[0])
+        expect(solutions[2]).to.equal(solutions[0])
+        expect(() => setupKnapsack(5, 1).intoptSync({ threads: 2, parDet: true })).to.throw(TypeError, /parDet/)
+    });
+
+    it('should branch with reliability branching', function() {
+        this.timeout(20000)
+        let reference = setupKnapsack(35, 17)
+        reference.intoptSync({ msgLev: glp.MSG_OFF })
+        let nodes = []
+        for (let threads of [1, 4]) {
+            let lp = setupKnapsack(35, 17)
+            let selected = 0
+            let ret = lp.intoptSync({
+                msgLev: glp.MSG_OFF, brTech: glp.BR_RLB, rbThreads: threads, rbItLim: 50,
+                cbReasons: glp.FSELECT, cbFunc: function() { selected++ }
+            })
+            expect(ret).to.equal(0)
+            expect(lp.mipObjVal()).to.equal(reference.mipObjVal())
+            nodes.push(selected)
+        }
+        // the choice does not depend on the threads
+        expect(nodes[1]).to.equal(nodes[0])
+    });
+
+    it('should stop strong branching at the lookahead on every thread count', function() {
+        this.timeout(20000)
+        // with 40 rows many nodes have more unreliable candidates than
+        // the lookahead, which then ends in the middle of a batch
+        let nodes = [1, 2, 3, 4, 8].map(function(threads) {
+            let lp = setupKnapsack(40, 7, 40)
+            let selected = 0
+            let ret = lp.intoptSync({
+                msgLev: glp.MSG_OFF, brTech: glp.BR_RLB, rbThreads: threads, rbItLim: 50,
+                cbReasons: glp.FSELECT, cbFunc: function() { selected++ }
+            })
+            expect(ret).to.equal(0)
+            expect(lp.mipObjVal()).to.equal(5154)
+            lp.delete()
+            return selected
+        })
+        expect(nodes).to.equal([953, 953, 953, 953, 953])
+    });
+
+    it('should generate the same cuts concurrently', function() {
+        this.timeout(20000)
+        let runs = [glp.OFF, glp.ON].map(function(parCuts) {
+            let lp = setupKnapsack(35, 19)
+            let nodes = 0
+            let ret = lp.intoptSync({
+                msgLev: glp.MSG_OFF, gmiCuts: glp.ON, mirCuts: glp.ON, covCuts: glp.ON, clqCuts: glp.ON, parCuts: parCuts,
+                cbReasons: glp.FSELECT, cbFunc: function() { nodes++ }
+            })
+            expect(ret).to.equal(0)
+            return { obj: lp.mipObjVal(), nodes: nodes }
+        })
+        expect(runs[1]).to.equal(runs[0])
+    });
+
+    it('should race parameter sets', function(done) {
+        this.timeout(20000)
+        let reference = setupKnapsack(35, 13)
+        reference.intoptSync({ msgLev: glp.MSG_OFF })
+        let lp = setupKnapsack(35, 13)
+        expect(() => lp.intopt({ race: [] }, function() {})).to.throw(TypeError, /race/)
+        expect(() => lp.intopt({ race: [{ cbFunc: function() {} }] }, function() {})).to.throw(TypeError, /race/)
+        expect(() => lp.intopt({ cbFunc: function() {}, race: [{ cbFunc: function() {} }] }, function() {})).to.throw(TypeError, /race/)
+        expect(() => lp.intopt({ saveSol: 'race.sol', race: [{ saveSol: 'race.sol' }] }, function() {})).to.throw(TypeError, /race/)
+        expect(() => lp.intoptSync({ race: [{}] })).to.throw(TypeError, /race/)
+        let race = [{}, { brTech: glp.BR_MFV, btTech: glp.BT_DFS }, { gmiCuts: glp.ON, mirCuts: glp.ON }, { fpHeur: glp.ON }]
+        lp.intopt({ msgLev: glp.MSG_OFF, race: race }, function(err, result) {
+            expect(err).to.be.null()
+            expect(result.ret).to.equal(0)
+            expect(result.winner).to.be.within(0, race.length - 1)
+            expect(result.rets[result.winner]).to.equal(0)
+            expect(result.injected.length).to.equal(race.length)
+            expect(lp.mipStatus()).to.equal(glp.OPT)
+            expect(lp.mipObjVal()).to.equal(reference.mipObjVal())
+            done()
+        })
+    });
+
+    it('should call cbFunc only for the cbReasons asked for', function(done) {
+        this.timeout(10000)
+        let lp = setupKnapsack(30, 7)
+        let reasons = new Set()
+        let reports = 0
+        lp.intopt({
+            msgLev: glp.MSG_OFF,
+            cbReasons: glp.FBRANCH,
+            cbFunc: function(tree) { reasons.add(tree.reason()) },
+            cbProgress: function() { reports++ }
+        }, function(err, ret) {
+            expect(ret).to.equal(0)
+            expect(reports).to.be.above(0)
+            // the call made once the search is over has no reason
+            reasons.delete(0)
+            expect([...reasons]).to.equal([glp.IBRANCH])
+            expect(() => lp.intoptSync({ cbProgress: function() {} })).to.throw(TypeError, /cbProgress/)
+            done()
+        })
+    });
 })
 
 describe("Interior point problem tests", function() {
@@ -142,6 +472,60 @@ describe("Interior point problem tests", function() {
     });
 })
 
+describe("Cancellation tests", function() {
+    it('should stop an async simplex with ECANCEL', function(done) {
+        this.timeout(10000)
+        let lp = setupDenseLP(300, 1)
+        expect(lp.cancel()).to.be.false()
+        lp.simplex({ msgLev: glp.MSG_OFF }, function(err, ret) {
+            expect(err).to.be.null()
+            expect(ret).to.equal(glp.ECANCEL)
+            expect(lp.getStatus()).to.not.equal(glp.OPT)
+            lp.simplex({ msgLev: glp.MSG_OFF }, function(err, ret) {
+                expect(ret).to.equal(0)
+                expect(lp.getStatus()).to.equal(glp.OPT)
+                done()
+            })
+        })
+        expect(lp.cancel()).to.be.true()
+    });
+
+    it('should stop an async interior-point solve with ECANCEL', function(done) {
+        this.timeout(10000)
+        let lp = setupDenseLP(300, 1)
+        lp.interior({ msgLev: glp.MSG_OFF }, function(err, ret) {
+            expect(err).to.be.null()
+            expect(ret).to.equal(glp.ECANCEL)
+            expect(lp.iptStatus()).to.equal(glp.INFEAS)
+            done()
+        })
+        lp.cancel()
+    });
+})
+
+describe("Concurrent solve tests", function() {
+    it('should keep the solution of the first solver done', function(done) {
+        this.timeout(10000)
+        let lp = setupSimplexLP()
+        lp.solveConcurrent({ simplex: { msgLev: glp.MSG_OFF } }, function(err, result) {
+            expect(err).to.be.null()
+            expect(result.ret).to.equal(0)
+            expect(['primal', 'dual', 'interior']).to.include(result.winner)
+            if (result.winner === 'interior') {
+                expect(lp.iptStatus()).to.equal(glp.OPT)
+                expect(lp.iptObjVal()).to.be.within(...nearly(733 + 1/3, 10000))
+            } else {
+                expect(lp.getStatus()).to.equal(glp.OPT)
+                expect(lp.getObjVal()).to.be.within(...nearly(733 + 1/3))
+                expect(lp.getColPrim(2)).to.be.within(...nearly(66 + 2/3))
+            }
+            done()
+        })
+        expect(() => lp.getObjVal()).to.throw(TypeError, 'an async operation is inprogress')
+        expect(() => setupSimplexLP().solveConcurrent({ simplex: 1 }, function() {})).to.throw(TypeError, /simplex/)
+    });
+})
+
 describe("Factorize problem tests", function() {
     it('should get the correct answer', function(done) {
         this.timeout(10000)
@@ -238,4 +622,405 @@ describe("Test glp_intopt_start, glp_intopt_run, glp_intopt_stop flow", function
     });
 })
 
+describe("Matrix loading tests", function() {
+    it('should read row data from typed array views', function() {
+        let lp = setupSimplexLP()
+        // element 0 of each view is ignored, so the row data starts at offset 4
+        let ind = new Int32Array([0, 0, 0, 0, 0, 1, 3])
+        let val = new Float64Array([0, 0, 0, 0, 0, 7.5, -2.5])
+        lp.setMatRow(2, ind.subarray(4), val.subarray(4))
+
+        let count = lp.getMatRow(2, function(ja, ar) {
+            expect(ja[1]).to.equal(1)
+            expect(ar[1]).to.equal(7.5)
+            expect(ja[2]).to.equal(3)
+            expect(ar[2]).to.equal(-2.5)
+        })
+        expect(count).to.equal(2)
+        expect(lp.getNumNz()).to.equal(8)
+    });
+
+    it('should reject arrays shorter than the number of elements', function() {
+        let lp = new glp.Problem()
+        lp.addRows(2)
+        lp.addCols(2)
+        let ia = new Int32Array([0, 1, 2])
+        let ja = new Int32Array([0, 1, 2])
+        let ar = new Float64Array([0, 1.0, 2.0])
+        expect(() => lp.loadMatrix(3, ia, ja, ar)).to.throw(TypeError, 'Invalid arrays length')
+        lp.loadMatrix(2, ia, ja, ar)
+        expect(lp.getNumNz()).to.equal(2)
+    });
+})
+
+describe("Solution array tests", function() {
+    it('should return the same values as the per-index getters', function(done) {
+        this.timeout(10000)
+        let lp = setupSimplexLP()
+        lp.simplex({}, function() {
+            let colPrim = lp.getColPrimArray()
+            let colDual = lp.getColDualArray()
+            let rowPrim = lp.getRowPrimArray()
+            let rowDual = lp.getRowDualArray()
+            let colStat = lp.getColStatArray()
+
+            expect(colPrim).to.be.an.instanceof(Float64Array)
+            expect(colStat).to.be.an.instanceof(Int32Array)
+            expect(colPrim.length).to.equal(lp.getNumCols() + 1)
+            expect(rowDual.length).to.equal(lp.getNumRows() + 1)
+            for (let j = 1; j <= lp.getNumCols(); j++) {
+                expect(colPrim[j]).to.equal(lp.getColPrim(j))
+                expect(colDual[j]).to.equal(lp.getColDual(j))
+                expect(colStat[j]).to.equal(lp.getColStat(j))
+            }
+            for (let i = 1; i <= lp.getNumRows(); i++) {
+                expect(rowPrim[i]).to.equal(lp.getRowPrim(i))
+                expect(rowDual[i]).to.equal(lp.getRowDual(i))
+            }
+            done()
+        })
+    });
+
+    it('should fill a caller supplied array', function() {
+        let lp = setupSimplexLP()
+        lp.simplexSync({})
+        let out = new Float64Array(10)
+        expect(lp.getColPrimArray(out)).to.shallow.equal(out)
+        expect(out[1]).to.equal(lp.getColPrim(1))
+        expect(() => lp.getColPrimArray(new Float64Array(3))).to.throw(TypeError, 'Invalid Array size')
+        expect(() => lp.getColPrimArray(new Int32Array(4))).to.throw(TypeError, 'Wrong arguments')
+    });
+})
+
+describe("Batched setter tests", function() {
+    it('should apply bounds, objective and kinds from typed arrays', function() {
+        let lp = setupSimplexLP()
+        lp.setColBndsArray(new Int32Array([0, 1, 3]), new Int32Array([0, glp.DB, glp.FX]),
+            new Float64Array([0, 1.0, 2.0]), new Float64Array([0, 5.0, 2.0]))
+        lp.setRowBndsArray(new Int32Array([0, 2]), new Int32Array([0, glp.LO]),
+            new Float64Array([0, -1.0]), new Float64Array([0, 0.0]))
+        lp.setObjCoefArray(new Int32Array([0, 0, 2]), new Float64Array([0, 3.5, 8.0]))
+        lp.setColKindArray(new Int32Array([0, 2, 3]), new Int32Array([0, glp.IV, glp.BV]))
+
+        expect(lp.getColType(1)).to.equal(glp.DB)
+        expect(lp.getColLb(1)).to.equal(1.0)
+        expect(lp.getColUb(1)).to.equal(5.0)
+        expect(lp.getColType(3)).to.equal(glp.FX)
+        expect(lp.getRowType(2)).to.equal(glp.LO)
+        expect(lp.getRowLb(2)).to.equal(-1.0)
+        expect(lp.getObjCoef(0)).to.equal(3.5)
+        expect(lp.getObjCoef(2)).to.equal(8.0)
+        expect(lp.getColKind(2)).to.equal(glp.IV)
+        expect(lp.getColKind(3)).to.equal(glp.BV)
+    });
+
+    it('should reject out of range indices before changing anything', function() {
+        let lp = setupSimplexLP()
+        expect(() => lp.setObjCoefArray(new Int32Array([0, 1, 4]), new Float64Array([0, 1.0, 1.0])))
+            .to.throw(TypeError, 'Index out of range')
+        expect(lp.getObjCoef(1)).to.equal(10.0)
+        expect(() => lp.setColBndsArray(new Int32Array([0, 1]), new Int32Array([0, 9]),
+            new Float64Array([0, 0.0]), new Float64Array([0, 0.0]))).to.throw(TypeError, 'Invalid type')
+    });
+})
+
+describe("Problem descriptor tests", function() {
+    function sampleDescriptor(matrix) {
+        return {
+            name: 'sample', objDir: glp.MAX, rows: 3, cols: 3, matrix: matrix,
+            names: { rows: [null, 'p', 'q', 'r'], cols: [null, 'x1', 'x2', 'x3'] },
+            bounds: {
+                rows: { type: new Int32Array([0, glp.UP, glp.UP, glp.UP]),
+                        lb: new Float64Array(4), ub: new Float64Array([0, 100.0, 600.0, 300.0]) },
+                cols: { type: new Int32Array([0, glp.LO, glp.LO, glp.LO]),
+                        lb: new Float64Array(4), ub: new Float64Array(4) }
+            },
+            obj: new Float64Array([0, 10.0, 6.0, 4.0])
+        }
+    }
+
+    it('should build the same problem from csr, csc and coo matrices', function() {
+        let matrices = [
+            { format: 'csr', start: new Int32Array([0, 1, 4, 7, 10]),
+              index: new Int32Array([0, 1, 2, 3, 1, 2, 3, 1, 2, 3]),
+              value: new Float64Array([0, 1.0, 1.0, 1.0, 10.0, 4.0, 5.0, 2.0, 2.0, 6.0]) },
+            { format: 'csc', start: new Int32Array([0, 1, 4, 7, 10]),
+              index: new Int32Array([0, 1, 2, 3, 1, 2, 3, 1, 2, 3]),
+              value: new Float64Array([0, 1.0, 10.0, 2.0, 1.0, 4.0, 2.0, 1.0, 5.0, 6.0]) },
+            { format: 'coo', ia: new Int32Array([0, 1, 1, 1, 2, 3, 2, 3, 2, 3]),
+              ja: new Int32Array([0, 1, 2, 3, 1, 1, 2, 2, 3, 3]),
+              ar: new Float64Array([0, 1.0, 1.0, 1.0, 10.0, 2.0, 4.0, 2.0, 5.0, 6.0]) }
+        ]
+        matrices.forEach(function(matrix) {
+            let lp = glp.Problem.fromDescriptor(sampleDescriptor(matrix))
+            expect(lp).to.be.an.instanceof(glp.Problem)
+            expect(lp.getProbName()).to.equal('sample')
+            expect(lp.getRowName(2)).to.equal('q')
+            expect(lp.getNumNz()).to.equal(9)
+            lp.simplexSync({})
+            expect(lp.getObjVal()).to.be.within(...(nearly(733 + 1/3)))
+        })
+    });
+
+    it('should build asynchronously', function(done) {
+        this.timeout(10000)
+        let desc = sampleDescriptor({ format: 'csr', start: new Int32Array([0, 1, 4, 7, 10]),
+            index: new Int32Array([0, 1, 2, 3, 1, 2, 3, 1, 2, 3]),
+            value: new Float64Array([0, 1.0, 1.0, 1.0, 10.0, 4.0, 5.0, 2.0, 2.0, 6.0]) })
+        glp.Problem.fromDescriptor(desc, function(err, lp) {
+            expect(err).to.be.null()
+            expect(lp.getNumNz()).to.equal(9)
+            lp.simplexSync({})
+            expect(lp.getObjVal()).to.be.within(...(nearly(733 + 1/3)))
+            done()
+        })
+    });
+
+    it('should reject invalid matrices without aborting', function(done) {
+        let dup = sampleDescriptor({ format: 'coo', ia: new Int32Array([0, 1, 1]),
+            ja: new Int32Array([0, 2, 2]), ar: new Float64Array([0, 1.0, 1.0]) })
+        expect(() => glp.Problem.fromDescriptor(dup)).to.throw(TypeError, /duplicate indices/)
+        let range = sampleDescriptor({ format: 'csr', start: new Int32Array([0, 1, 2, 2, 2]),
+            index: new Int32Array([0, 4]), value: new Float64Array([0, 1.0]) })
+        expect(() => glp.Problem.fromDescriptor(range)).to.throw(TypeError, /Index out of range/)
+        expect(() => glp.Problem.fromDescriptor({ rows: 1, cols: 1, matrix: { format: 'dense' } }))
+            .to.throw(TypeError, /matrix.format/)
+        glp.Problem.fromDescriptor(range, function(err) {
+            expect(err).to.be.an.error(/Index out of range/)
+            done()
+        })
+    });
+})
+
+describe("Matrix export tests", function() {
+    it('should match getMatRow and getMatCol', function() {
+        let lp = setupSimplexLP()
+        let csr = lp.getMatrix()
+        let csc = lp.getMatrix({ format: 'csc' })
+        expect(csr.format).to.equal('csr')
+        expect(csr.start).to.equal(new Int32Array([0, 1, 4, 7, 10]))
+        expect(csc.start).to.equal(new Int32Array([0, 1, 4, 7, 10]))
+        expect(csr.index.length).to.equal(lp.getNumNz() + 1)
+        for (let i = 1; i <= 3; i++) {
+            lp.getMatRow(i, function(ind, val) {
+                expect(csr.index.slice(csr.start[i], csr.start[i + 1])).to.equal(ind.slice(1))
+                expect(csr.value.slice(csr.start[i], csr.start[i + 1])).to.equal(val.slice(1))
+            })
+            lp.getMatCol(i, function(ind, val) {
+                expect(csc.index.slice(csc.start[i], csc.start[i + 1])).to.equal(ind.slice(1))
+                expect(csc.value.slice(csc.start[i], csc.start[i + 1])).to.equal(val.slice(1))
+            })
+        }
+        expect(() => lp.getMatrix({ format: 'coo' })).to.throw(TypeError, /format/)
+    });
+
+    it('should round trip through fromDescriptor', function() {
+        let lp = setupSimplexLP()
+        let copy = glp.Problem.fromDescriptor({ rows: 3, cols: 3, matrix: lp.getMatrix({ format: 'csc' }) })
+        expect(copy.getNumNz()).to.equal(9)
+        lp.sortMatrix()
+        copy.sortMatrix()
+        expect(copy.getMatrix()).to.equal(lp.getMatrix())
+    });
+})
+
+describe("Solver pool tests", function() {
+    after(function() {
+        glp.solverPool({ threads: 0 })
+    })
+
+    it('should run async solves on the dedicated threads', function(done) {
+        this.timeout(10000)
+        glp.solverPool({ threads: 2, affinity: [0] })
+        expect(glp.solverPoolStats().threads).to.equal(2)
+        let lp = setupSimplexLP()
+        lp.simplex({}, function(err) {
+            expect(err).to.not.exist()
+            expect(lp.getObjVal()).to.be.within(...(nearly(733 + 1/3)))
+            setImmediate(function() {
+                let stats = glp.solverPoolStats()
+                expect(stats.submitted).to.equal(1)
+                expect(stats.completed).to.equal(1)
+                expect(stats.queued).to.equal(0)
+                expect(stats.utilization).to.be.within(0, 1)
+                done()
+            })
+        })
+        expect(() => glp.solverPool({ threads: 1 })).to.throw(TypeError, 'the solver pool is busy')
+    });
+})
+
+describe("Operation queue tests", function() {
+    it('should run queued operations in order and resolve each promise', function() {
+        this.timeout(10000)
+        let lp = setupSimplexLP()
+        let order = []
+        let bounds = lp.enqueue('setColBnds', 1, glp.DB, 0.0, 10.0).then(() => order.push('bounds'))
+        let solve = lp.enqueue('simplex', {})
+        let obj = lp.enqueue('getObjVal')
+        let prim = lp.enqueue('getColPrimArray')
+        expect(() => lp.getObjVal()).to.throw(TypeError, 'an async operation is inprogress')
+        return Promise.all([bounds, solve.then((ret) => { order.push('simplex'); return ret }), obj, prim])
+            .then(function(results) {
+                expect(order).to.equal(['bounds', 'simplex'])
+                expect(results[1]).to.equal(0)
+                expect(results[2]).to.be.within(...(nearly(10 * 10 + 6 * 90, 1000)))
+                expect(results[3]).to.be.an.instanceof(Float64Array)
+                expect(results[3][1]).to.equal(lp.getColPrim(1))
+            })
+    });
+
+    it('should reject a failing operation and keep going', function() {
+        let lp = setupSimplexLP()
+        let bad = lp.enqueue('setObjCoef', 7, 1.0)
+        let ok = lp.enqueue('getStatus')
+        expect(() => lp.enqueue('frobnicate')).to.throw(TypeError, 'Unknown operation: frobnicate')
+        return bad.then(() => { throw new Error('should have failed') }, function(err) {
+            expect(err.message).to.contain('Index out of range')
+            return ok
+        }).then((status) => expect(status).to.equal(glp.UNDEF))
+    });
+})
+
+describe("Batch solve tests", function() {
+    it('should solve every problem and report per-problem results', function(done) {
+        this.timeout(10000)
+        let problems = []
+        for (let k = 0; k < 8; k++) {
+            let lp = setupSimplexLP()
+            lp.setObjCoef(1, 10.0 + k)
+            problems.push(lp)
+        }
+        glp.solveBatch(problems, { method: 'simplex', opts: { msgLev: glp.MSG_OFF }, concurrency: 3 }, function(err, result) {
+            expect(err).to.be.null()
+            expect(result.status).to.be.an.instanceof(Int32Array)
+            expect(result.status.length).to.equal(8)
+            for (let k = 0; k < 8; k++) {
+                expect(result.ret[k]).to.equal(0)
+                expect(result.status[k]).to.equal(glp.OPT)
+                expect(result.obj[k]).to.equal(problems[k].getObjVal())
+            }
+            expect(result.obj[0]).to.be.within(...(nearly(733 + 1/3)))
+            done()
+        })
+        expect(() => problems[0].getObjVal()).to.throw(TypeError, 'an async operation is inprogress')
+    });
+
+    it('should reject invalid batches', function() {
+        let lp = setupSimplexLP()
+        expect(() => glp.solveBatch([lp, lp], {}, function() {})).to.throw(TypeError, /listed twice/)
+        expect(() => glp.solveBatch([{}], {}, function() {})).to.throw(TypeError, /Problem objects/)
+        expect(() => glp.solveBatch([lp], { method: 'dual' }, function() {})).to.throw(TypeError, /method/)
+    });
+})
 
+describe("MIP scheduler tests", function() {
+    // random multi-constraint knapsack, small enough to solve but with a few hundred subproblems
+    it('should solve jobs of different priorities and report progress', function(done) {
+        this.timeout(20000)
+        glp.mipScheduler({ threads: 2, sliceMs: 2 })
+        let pending = 3
+        let reports = 0
+        for (let k = 0; k < 3; k++) {
+            let lp = setupKnapsack(40, k + 1)
+            let reference = setupKnapsack(40, k + 1)
+            reference.intoptSync({ msgLev: glp.MSG_OFF })
+            lp.scheduleIntopt({ msgLev: glp.MSG_OFF }, {
+                priority: k,
+                progress: function(p) {
+                    expect(p.nodes).to.be.at.least(p.active)
+                    reports++
+                }
+            }, function(err, ret) {
+                expect(err).to.be.null()
+                expect(ret).to.equal(0)
+                expect(lp.mipStatus()).to.equal(glp.OPT)
+                expect(lp.mipObjVal()).to.equal(reference.mipObjVal())
+                if (--pending == 0) {
+                    expect(reports).to.be.above(0)
+                    expect(glp.mipSchedulerStats().completed).to.be.at.least(3)
+                    done()
+                }
+            })
+            expect(() => lp.getObjVal()).to.throw(TypeError, 'an async operation is inprogress')
+        }
+    });
+
+    it('should hold a paused job until it is resumed', function(done) {
+        this.timeout(20000)
+        let lp = setupKnapsack(40, 7)
+        let resumed = false
+        lp.scheduleIntopt({ msgLev: glp.MSG_OFF }, null, function(err, ret) {
+            expect(ret).to.equal(0)
+            expect(resumed).to.be.true()
+            expect(lp.pause()).to.be.false()
+            done()
+        })
+        expect(lp.pause()).to.be.true()
+        setTimeout(function() {
+            expect(glp.mipSchedulerStats().paused).to.equal(1)
+            resumed = true
+            expect(lp.resume()).to.be.true()
+        }, 50)
+    });
+
+    it('should stop a cancelled job with ESTOP', function(done) {
+        this.timeout(20000)
+        let lp = setupKnapsack(40, 11)
+        lp.scheduleIntopt({ msgLev: glp.MSG_OFF }, null, function(err, ret) {
+            expect(ret).to.equal(glp.ESTOP)
+            done()
+        })
+        lp.pause()
+        expect(lp.cancel()).to.be.true()
+    });
+
+    it('should reject invalid arguments', function() {
+        let lp = setupKnapsack(5, 3)
+        expect(() => lp.scheduleIntopt({ cbFunc: function() {} }, null, function() {})).to.throw(TypeError, /cbFunc/)
+        expect(() => lp.scheduleIntopt({}, { deadline: -1 }, function() {})).to.throw(TypeError, /deadline/)
+        expect(() => glp.mipScheduler({ threads: 1, sliceMs: 0 })).to.throw(TypeError, /sliceMs or sliceNodes/)
+        lp.getObjVal()
+    });
+})
+
+describe("Scheduled simplex tests", function() {
+    it('should continue a paused simplex to the same solution', function(done) {
+        this.timeout(20000)
+        glp.mipScheduler({ threads: 1, sliceMs: 1 })
+        let lp = setupDenseLP(150, 5)
+        let reference = setupDenseLP(150, 5)
+        reference.simplexSync({ msgLev: glp.MSG_OFF })
+        let iterations = 0
+        lp.scheduleSimplex({ msgLev: glp.MSG_OFF }, {
+            progress: function(p) {
+                expect(p.iterations).to.be.at.least(iterations)
+                iterations = p.iterations
+            }
+        }, function(err, ret) {
+            expect(err).to.be.null()
+            expect(ret).to.equal(0)
+            expect(lp.getStatus()).to.equal(glp.OPT)
+            expect(lp.getObjVal()).to.be.within(...(nearly(reference.getObjVal(), 1000000)))
+            expect(lp.getItCnt()).to.equal(reference.getItCnt())
+            done()
+        })
+        expect(lp.pause()).to.be.true()
+        setTimeout(function() {
+            expect(glp.mipSchedulerStats().paused).to.equal(1)
+            expect(lp.resume()).to.be.true()
+        }, 20)
+    });
+
+    it('should stop a cancelled simplex with ECANCEL', function(done) {
+        this.timeout(20000)
+        let lp = setupDenseLP(300, 5)
+        lp.scheduleSimplex(null, null, function(err, ret) {
+            expect(ret).to.equal(glp.ECANCEL)
+            expect(lp.getStatus()).to.not.equal(glp.OPT)
+            done()
+        })
+        lp.pause()
+        expect(lp.cancel()).to.be.true()
+    });
+})